@@ -0,0 +1,5126 @@
+/**
+  ******************************************************************************
+  * @file    ais2dw12_dsp.c
+  * @author  Sensors Software Solution Team
+  * @brief   AIS2DW12 host-side processing of the driver data
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+#include "ais2dw12_dsp.h"
+
+/**
+  * @defgroup  AIS2DW12_DSP
+  * @brief     This file provides the host-side processing of the data
+  *            read by the ais2dw12 driver. Device accesses go through
+  *            the driver APIs.
+  * @{
+  *
+  */
+
+/**
+  * @defgroup  DSP_Private_functions
+  * @brief     Section collect all the utility functions needed by APIs.
+  * @{
+  *
+  */
+
+static void bytecpy(uint8_t *target, uint8_t *source)
+{
+  if ((target != NULL) && (source != NULL))
+  {
+    *target = *source;
+  }
+}
+
+static float_t fs_sens(uint8_t fs)
+{
+  return (fs == (uint8_t)AIS2DW12_4g) ? ais2dw12_from_fs4_to_mg(1) :
+         ais2dw12_from_fs2_to_mg(1);
+}
+
+static uint16_t blk_queue_room(const ais2dw12_blk_queue_t *queue)
+{
+  return (uint16_t)((queue->rec + queue->size - queue->head - 1U) %
+                    queue->size);
+}
+
+static void stats_out_set(ais2dw12_stats_out_t *out, uint8_t axis,
+                          float_t n, float_t mean, float_t m2, float_t m3,
+                          float_t m4, float_t min, float_t max)
+{
+  float_t ms;
+  float_t var;
+
+  var = (m2 > 0.0f) ? (m2 / n) : 0.0f;
+  ms = (mean * mean) + var;
+
+  out->mean[axis] = mean;
+  out->rms[axis] = sqrtf(ms);
+  out->peak[axis] = (-min > max) ? -min : max;
+  out->p2p[axis] = max - min;
+  out->crest[axis] = (ms > 0.0f) ? (out->peak[axis] / out->rms[axis]) : 0.0f;
+  out->skew[axis] = (var > 0.0f) ? ((m3 / n) / (var * sqrtf(var))) : 0.0f;
+  out->kurt[axis] = (var > 0.0f) ? ((m4 / n) / (var * var)) : 0.0f;
+}
+
+static void stats_sl_rebase(ais2dw12_stats_sl_t *st, uint8_t axis)
+{
+  const float_t *buf;
+  float_t d;
+  float_t d2;
+  uint16_t i;
+
+  buf = &st->buf[axis * st->win];
+  st->k[axis] += st->s[axis][0] / (float_t)st->n;
+  st->s[axis][0] = 0.0f;
+  st->s[axis][1] = 0.0f;
+  st->s[axis][2] = 0.0f;
+  st->s[axis][3] = 0.0f;
+
+  for (i = 0U; i < st->n; i++)
+  {
+    d = buf[i] - st->k[axis];
+    d2 = d * d;
+    st->s[axis][0] += d;
+    st->s[axis][1] += d2;
+    st->s[axis][2] += d2 * d;
+    st->s[axis][3] += d2 * d2;
+  }
+}
+
+static void stats_sl_renumber(ais2dw12_stats_sl_t *st, uint32_t off)
+{
+  uint32_t *q;
+  uint32_t i;
+  uint8_t a;
+  uint8_t j;
+
+  for (a = 0U; a < 3U; a++)
+  {
+    for (j = 0U; j < 2U; j++)
+    {
+      q = &st->dq[((2U * a) + j) * st->win];
+
+      for (i = st->head[a][j]; i != st->tail[a][j]; i++)
+      {
+        q[i % st->win] -= off;
+      }
+
+      i = st->head[a][j] - (st->head[a][j] % st->win);
+      st->head[a][j] -= i;
+      st->tail[a][j] -= i;
+    }
+  }
+
+  st->cnt -= off;
+}
+
+static float_t fast_atan2(float_t y, float_t x)
+{
+  float_t ax;
+  float_t ay;
+  float_t a;
+  float_t s;
+  float_t r;
+
+  ax = (x < 0.0f) ? -x : x;
+  ay = (y < 0.0f) ? -y : y;
+
+  if ((ax == 0.0f) && (ay == 0.0f))
+  {
+    r = 0.0f;
+  }
+
+  else
+  {
+    /* minimax polynomial of atan on [0, 1], error < 2e-6 rad */
+    a = (ax > ay) ? (ay / ax) : (ax / ay);
+    s = a * a;
+    r = (s * -0.01172120f) + 0.05265332f;
+    r = (s * r) - 0.11643287f;
+    r = (s * r) + 0.19354346f;
+    r = (s * r) - 0.33262347f;
+    r = a * ((s * r) + 0.99997726f);
+
+    if (ay > ax)
+    {
+      r = 1.57079637f - r;
+    }
+
+    if (x < 0.0f)
+    {
+      r = 3.14159274f - r;
+    }
+
+    if (y < 0.0f)
+    {
+      r = -r;
+    }
+  }
+
+  return r;
+}
+
+static void allan_acc(ais2dw12_allan_lvl_t *l, float_t d)
+{
+  float_t y;
+  float_t t;
+
+  /* compensated sum: long captures don't lose the small terms */
+  y = (d * d) - l->comp;
+  t = l->sum + y;
+  l->comp = (t - l->sum) - y;
+  l->sum = t;
+  l->cnt++;
+}
+
+static int32_t ofs_quantize(float_t mg, float_t lsb, int8_t *ofs)
+{
+  float_t q;
+  int32_t ret;
+
+  ret = 0;
+  q = mg / lsb;
+  q = (q < 0.0f) ? (q - 0.5f) : (q + 0.5f);
+
+  if (q > 127.0f)
+  {
+    q = 127.0f;
+    ret = -1;
+  }
+
+  else if (q < -127.0f)
+  {
+    q = -127.0f;
+    ret = -1;
+  }
+
+  else
+  {
+    /* in range */
+  }
+
+  *ofs = (int8_t)q;
+
+  return ret;
+}
+
+static int32_t tcomp_poly_fit(const ais2dw12_tcomp_pt_t *pt, uint16_t num,
+                              uint8_t deg, float_t c[4][6])
+{
+  float_t m[4][10];
+  float_t pw[7];
+  float_t u;
+  float_t f;
+  uint16_t i;
+  uint8_t n;
+  uint8_t r;
+  uint8_t k;
+  uint8_t j;
+  uint8_t p;
+  int32_t ret;
+
+  n = deg + 1U;
+  ret = 0;
+
+  for (r = 0U; r < n; r++)
+  {
+    for (j = 0U; j < (n + 6U); j++)
+    {
+      m[r][j] = 0.0f;
+    }
+  }
+
+  /* normal equations in u = (t - 25) / 50, right-hand side per quantity */
+  for (i = 0U; i < num; i++)
+  {
+    u = (pt[i].temp_c - 25.0f) / 50.0f;
+    pw[0] = 1.0f;
+
+    for (k = 1U; k < 7U; k++)
+    {
+      pw[k] = pw[k - 1U] * u;
+    }
+
+    for (r = 0U; r < n; r++)
+    {
+      for (k = 0U; k < n; k++)
+      {
+        m[r][k] += pw[r + k];
+      }
+
+      for (k = 0U; k < 3U; k++)
+      {
+        m[r][n + k] += pw[r] * pt[i].bias[k];
+        m[r][n + 3U + k] += pw[r] * pt[i].scale[k];
+      }
+    }
+  }
+
+  /* Gauss-Jordan elimination with partial pivoting */
+  for (k = 0U; (k < n) && (ret == 0); k++)
+  {
+    p = k;
+
+    for (r = k + 1U; r < n; r++)
+    {
+      if (fabsf(m[r][k]) > fabsf(m[p][k]))
+      {
+        p = r;
+      }
+    }
+
+    if (fabsf(m[p][k]) < 1.0e-6f)
+    {
+      ret = -1;
+    }
+
+    else
+    {
+      for (j = 0U; j < (n + 6U); j++)
+      {
+        f = m[k][j];
+        m[k][j] = m[p][j];
+        m[p][j] = f;
+      }
+
+      for (r = 0U; r < n; r++)
+      {
+        if (r != k)
+        {
+          f = m[r][k] / m[k][k];
+
+          for (j = k; j < (n + 6U); j++)
+          {
+            m[r][j] -= f * m[k][j];
+          }
+        }
+      }
+    }
+  }
+
+  for (r = 0U; (r < 4U) && (ret == 0); r++)
+  {
+    for (j = 0U; j < 6U; j++)
+    {
+      c[r][j] = (r < n) ? (m[r][n + j] / m[r][r]) : 0.0f;
+    }
+  }
+
+  return ret;
+}
+
+static void hist_flush(uint32_t *hist, uint16_t *out, uint16_t num)
+{
+  uint16_t i;
+
+  for (i = 0U; i < num; i++)
+  {
+    out[i] = (hist[i] > 0xFFFFU) ? 0xFFFFU : (uint16_t)hist[i];
+    hist[i] = 0U;
+  }
+}
+
+static void rfc_count(ais2dw12_rfc_t *st, float_t range, uint32_t half)
+{
+  uint16_t bin;
+
+  range = fabsf(range);
+  bin = ((range / st->bin_mg) >= (float_t)st->bins) ?
+        (st->bins - 1U) : (uint16_t)(range / st->bin_mg);
+  st->hist[bin] += half;
+}
+
+static void rfc_push(ais2dw12_rfc_t *st, float_t rev)
+{
+  float_t *s;
+  float_t x;
+  uint16_t d;
+  uint16_t i;
+  uint8_t closed;
+
+  s = st->stack;
+  closed = PROPERTY_ENABLE;
+
+  /* residue full: the oldest range is counted as a half cycle */
+  if (st->depth == AIS2DW12_RFC_DEPTH)
+  {
+    rfc_count(st, s[1] - s[0], 1U);
+
+    for (i = 1U; i < st->depth; i++)
+    {
+      s[i - 1U] = s[i];
+    }
+
+    st->depth--;
+  }
+
+  s[st->depth] = rev;
+  st->depth++;
+  d = st->depth;
+
+  /* four-point rule: an inner range enclosed by its neighbours closes
+   * a full cycle */
+  while ((d >= 4U) && (closed == PROPERTY_ENABLE))
+  {
+    x = fabsf(s[d - 2U] - s[d - 3U]);
+    closed = PROPERTY_DISABLE;
+
+    if ((x <= fabsf(s[d - 3U] - s[d - 4U])) &&
+        (x <= fabsf(s[d - 1U] - s[d - 2U])))
+    {
+      rfc_count(st, x, 2U);
+      s[d - 3U] = s[d - 1U];
+      d -= 2U;
+      closed = PROPERTY_ENABLE;
+    }
+  }
+
+  st->depth = d;
+}
+
+static void sort_net(int16_t *v, uint8_t w, uint16_t lanes)
+{
+  int16_t *a;
+  int16_t *b;
+  int16_t lo;
+  int16_t hi;
+  uint8_t r;
+  uint8_t j;
+  uint16_t l;
+
+  /* odd-even transposition network, w rounds of compare-exchange
+   * applied to all the lanes at once */
+  for (r = 0U; r < w; r++)
+  {
+    for (j = r % 2U; (j + 1U) < w; j += 2U)
+    {
+      a = &v[(uint32_t)j * lanes];
+      b = &a[lanes];
+
+      for (l = 0U; l < lanes; l++)
+      {
+        lo = (a[l] < b[l]) ? a[l] : b[l];
+        hi = (a[l] < b[l]) ? b[l] : a[l];
+        a[l] = lo;
+        b[l] = hi;
+      }
+    }
+  }
+}
+
+static int8_t nn_requant(int32_t acc, int32_t mult, int8_t shift, int16_t zp,
+                         uint8_t relu)
+{
+  int64_t p;
+  int32_t lim;
+  int32_t v;
+  int32_t r;
+
+  /* acc * mult * 2^(shift - 31), rounded to nearest; mult >= 2^30, so
+   * a pre-shift value saturated to 32 bits still saturates the output */
+  v = acc;
+
+  if (shift > 0)
+  {
+    lim = (int32_t)(0x7FFFFFFFU >> (uint8_t)shift);
+    r = (int32_t)1 << (uint8_t)shift;
+    v = (acc > lim) ? 0x7FFFFFFF : ((acc < -lim) ? -0x7FFFFFFF : (acc * r));
+  }
+
+  p = ((int64_t)v * mult) + ((int64_t)1 << 30);
+  v = (int32_t)(p >> 31);
+
+  if (shift < 0)
+  {
+    r = (int32_t)1 << (uint8_t)(-shift - 1);
+    v = (v + r) >> (uint8_t)(-shift);
+  }
+
+  v += zp;
+  v = ((relu != 0U) && (v < zp)) ? zp : v;
+  v = (v > 127) ? 127 : v;
+  v = (v < -128) ? -128 : v;
+
+  return (int8_t)v;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Pipeline
+  * @brief     This section groups the functions that move sample blocks
+  *            from the FIFO through a graph of processing stages
+  *            (source -> converter -> filter -> feature -> sink). Each
+  *            stage names its upstream stage: root stages are fed by the
+  *            FIFO source, the others by the stage they follow, which
+  *            forwards each block once it has run on it. Blocks are
+  *            passed by reference through a single producer / single
+  *            consumer queue per stage, the references of the whole
+  *            subtree are taken when the block enters a root stage.
+  *            Stages must not modify the raw samples: the converter
+  *            stage ais2dw12_stage_to_mg fills the mg planes of the
+  *            blocks once, so the stages that follow it read mg data
+  *            without converting again. Each stage runs when at least
+  *            batch samples are queued and its downstream queues have
+  *            room, either from the acquisition loop (synchronous stage)
+  *            or from its own thread through ais2dw12_stage_poll
+  *            (asynchronous stage). Blocks are given back to the pool
+  *            only by the acquisition loop, so the pool is never
+  *            accessed concurrently.
+  *            On multi-core hosts the platform must guarantee that the
+  *            queue indexes are published after the slot contents
+  *            (memory barrier in the stage code or in-order memory).
+  * @{
+  *
+  */
+
+/**
+  * @brief  Convert a raw sample block to mg using the full scale tag of
+  *         the block.
+  *
+  * @param  blk      raw sample block
+  * @param  x        buffer that stores X-axis data (blk->len elements)
+  * @param  y        buffer that stores Y-axis data (blk->len elements)
+  * @param  z        buffer that stores Z-axis data (blk->len elements)
+  *
+  */
+void ais2dw12_blk_to_mg(const ais2dw12_blk_t *blk, float_t *x, float_t *y,
+                        float_t *z)
+{
+  float_t sens;
+  uint16_t i;
+
+  sens = fs_sens(blk->fs);
+
+  for (i = 0U; i < blk->len; i++)
+  {
+    x[i] = (float_t)blk->x[i] * sens;
+    y[i] = (float_t)blk->y[i] * sens;
+    z[i] = (float_t)blk->z[i] * sens;
+  }
+}
+
+/**
+  * @brief  Attach mg planes to the blocks of a pool, needed by
+  *         ais2dw12_stage_to_mg. Call it after ais2dw12_blk_pool_init.
+  *
+  * @param  blk      array of num blocks given to ais2dw12_blk_pool_init
+  * @param  storage  buffer of AIS2DW12_BLK_MG_STORAGE_LEN(num, cap)
+  *                  elements
+  * @param  num      number of blocks
+  *
+  */
+void ais2dw12_blk_mg_attach(ais2dw12_blk_t *blk, float_t *storage,
+                            uint16_t num)
+{
+  uint32_t offs;
+  uint16_t i;
+
+  offs = 0U;
+
+  for (i = 0U; i < num; i++)
+  {
+    blk[i].mx = &storage[offs];
+    blk[i].my = &storage[offs + blk[i].cap];
+    blk[i].mz = &storage[offs + (2U * (uint32_t)blk[i].cap)];
+    offs += 3U * (uint32_t)blk[i].cap;
+  }
+}
+
+/**
+  * @brief  Initialize a stage block queue.
+  *
+  * @param  queue    block queue
+  * @param  slot     array of size block pointers
+  * @param  size     number of slots (one is kept free), at least 2
+  * @retval          0 -> no Error, -1 -> invalid size
+  *
+  */
+int32_t ais2dw12_blk_queue_init(ais2dw12_blk_queue_t *queue,
+                                ais2dw12_blk_t **slot, uint16_t size)
+{
+  int32_t ret;
+
+  if (size < 2U)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    queue->slot = slot;
+    queue->size = size;
+    queue->head = 0U;
+    queue->tail = 0U;
+    queue->rec = 0U;
+    ret = 0;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Run a stage on the queued blocks, if at least batch samples
+  *         are available and the downstream queues have room for them,
+  *         then forward the blocks to the downstream stages. Call it
+  *         from the stage thread for asynchronous stages. The blocks
+  *         passed to the stage are valid only until the stage returns.
+  *
+  * @param  stage    processing stage
+  * @retval          value returned by the stage, 0 if not run
+  *
+  */
+int32_t ais2dw12_stage_poll(ais2dw12_stage_t *stage)
+{
+  ais2dw12_blk_t *blk[AIS2DW12_STAGE_MAX_BLK];
+  ais2dw12_blk_queue_t *queue;
+  ais2dw12_stage_t *child;
+  uint16_t samples;
+  uint16_t room;
+  uint16_t tail;
+  uint16_t num;
+  uint16_t i;
+  int32_t ret;
+
+  queue = stage->queue;
+  tail = queue->tail;
+  samples = 0U;
+  num = 0U;
+
+  while ((tail != queue->head) && (num < AIS2DW12_STAGE_MAX_BLK))
+  {
+    blk[num] = queue->slot[tail];
+    samples += blk[num]->len;
+    num++;
+    tail = (uint16_t)((tail + 1U) % queue->size);
+  }
+
+  room = AIS2DW12_STAGE_MAX_BLK;
+
+  for (child = stage->child; child != NULL; child = child->sibling)
+  {
+    if (blk_queue_room(child->queue) < room)
+    {
+      room = blk_queue_room(child->queue);
+    }
+  }
+
+  if ((num > 0U) && (num <= room) &&
+      ((samples >= stage->batch) || (num == AIS2DW12_STAGE_MAX_BLK) ||
+       ((blk[num - 1U]->flags & AIS2DW12_BLK_CLOSED) != 0U)))
+  {
+    ret = stage->run(stage->state, blk, num);
+
+    /* the references were taken when the blocks entered the root stage */
+    for (child = stage->child; child != NULL; child = child->sibling)
+    {
+      for (i = 0U; i < num; i++)
+      {
+        child->queue->slot[child->queue->head] = blk[i];
+        child->queue->head = (uint16_t)((child->queue->head + 1U) %
+                                        child->queue->size);
+      }
+    }
+
+    queue->tail = tail;
+  }
+
+  else
+  {
+    ret = 0;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Converter stage: fill the mg planes of the blocks that don't
+  *         have them yet, using the full scale tag of each block. Feed
+  *         it from the source and chain the mg stages after it.
+  *
+  * @param  state    unused, may be NULL
+  * @param  blk      queued blocks, with mg planes attached
+  * @param  num      number of blocks
+  * @retval          0 -> no Error, -1 -> block without mg planes
+  *
+  */
+int32_t ais2dw12_stage_to_mg(void *state, ais2dw12_blk_t *const *blk,
+                             uint16_t num)
+{
+  uint16_t i;
+  int32_t ret;
+
+  (void)state;
+  ret = 0;
+
+  for (i = 0U; i < num; i++)
+  {
+    if (blk[i]->mx == NULL)
+    {
+      ret = -1;
+    }
+
+    else if ((blk[i]->flags & AIS2DW12_BLK_MG) == 0U)
+    {
+      ais2dw12_blk_to_mg(blk[i], blk[i]->mx, blk[i]->my, blk[i]->mz);
+      blk[i]->flags |= AIS2DW12_BLK_MG;
+    }
+
+    else
+    {
+      /* already converted upstream */
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Initialize a pipeline and link its stages. A stage must come
+  *         after its upstream stage in the array.
+  *
+  * @param  pipe     pipeline
+  * @param  pool     sample block pool
+  * @param  stream   stream descriptor
+  * @param  stage    array of num stages, with their queues initialized
+  *                  and their up field set
+  * @param  num      number of stages
+  * @retval          0 -> no Error, -1 -> upstream stage not before the
+  *                  stage or subtree too large for the block references
+  *
+  */
+int32_t ais2dw12_pipeline_init(ais2dw12_pipeline_t *pipe,
+                               ais2dw12_blk_pool_t *pool,
+                               ais2dw12_stream_t *stream,
+                               ais2dw12_stage_t *stage, uint16_t num)
+{
+  ais2dw12_stage_t *up;
+  uint16_t i;
+  int32_t ret;
+
+  pipe->pool = pool;
+  pipe->stream = stream;
+  pipe->stage = stage;
+  pipe->num = num;
+  pipe->cur = NULL;
+  pipe->dropped = 0U;
+  ret = 0;
+
+  for (i = 0U; i < num; i++)
+  {
+    stage[i].refs = 1U;
+    stage[i].child = NULL;
+    stage[i].sibling = NULL;
+  }
+
+  /* downstream stages first, so that their subtree size is final */
+  for (i = num; (i > 0U) && (ret == 0); i--)
+  {
+    if (stage[i - 1U].up == AIS2DW12_STAGE_SOURCE)
+    {
+      ret = (stage[i - 1U].refs < 0xFFU) ? 0 : -1;
+    }
+
+    else if (stage[i - 1U].up < (i - 1U))
+    {
+      up = &stage[stage[i - 1U].up];
+      up->refs += stage[i - 1U].refs;
+      stage[i - 1U].sibling = up->child;
+      up->child = &stage[i - 1U];
+    }
+
+    else
+    {
+      ret = -1;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Hand a block to the root stages, run the synchronous stages
+  *         and give back to the pool the blocks all the stages are done
+  *         with.
+  *
+  * @param  pipe     pipeline
+  * @param  blk      sample block to publish (NULL -> reclaim only)
+  * @retval          first error returned by a synchronous stage
+  *
+  */
+int32_t ais2dw12_pipeline_push(ais2dw12_pipeline_t *pipe,
+                               ais2dw12_blk_t *blk)
+{
+  ais2dw12_blk_queue_t *queue;
+  ais2dw12_stage_t *stage;
+  uint16_t i;
+  uint16_t k;
+  int32_t ret;
+  int32_t err;
+
+  ret = 0;
+
+  for (i = 0U; i < pipe->num; i++)
+  {
+    stage = &pipe->stage[i];
+    queue = stage->queue;
+
+    if ((blk != NULL) && (stage->up == AIS2DW12_STAGE_SOURCE))
+    {
+      if ((blk_queue_room(queue) == 0U) ||
+          (((uint16_t)blk->ref + stage->refs) > 0xFFU))
+      {
+        pipe->dropped++;
+      }
+
+      else
+      {
+        /* one reference for each stage the block goes through */
+        for (k = 0U; k < stage->refs; k++)
+        {
+          (void)ais2dw12_blk_ref(blk);
+        }
+
+        queue->slot[queue->head] = blk;
+        queue->head = (uint16_t)((queue->head + 1U) % queue->size);
+      }
+    }
+
+    if (stage->async == PROPERTY_DISABLE)
+    {
+      err = ais2dw12_stage_poll(stage);
+
+      if (ret == 0)
+      {
+        ret = err;
+      }
+    }
+
+    while (queue->rec != queue->tail)
+    {
+      ais2dw12_blk_release(pipe->pool, queue->slot[queue->rec]);
+      queue->rec = (uint16_t)((queue->rec + 1U) % queue->size);
+    }
+  }
+
+  if (blk != NULL)
+  {
+    ais2dw12_blk_release(pipe->pool, blk);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Pipeline source: drain the FIFO into the current block and
+  *         publish it to the stages once it is full or closed. Call it
+  *         on FIFO threshold event or periodically. To change the
+  *         configuration use ais2dw12_pipeline_reconfig.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  pipe     pipeline
+  * @retval          interface status (MANDATORY: return 0 -> no Error),
+  *                  -1 if the pool is exhausted, otherwise first error
+  *                  returned by a synchronous stage
+  *
+  */
+int32_t ais2dw12_pipeline_run(const stmdev_ctx_t *ctx,
+                              ais2dw12_pipeline_t *pipe)
+{
+  int32_t ret;
+
+  ret = 0;
+
+  if (pipe->cur == NULL)
+  {
+    pipe->cur = ais2dw12_blk_alloc(pipe->pool);
+  }
+
+  if (pipe->cur == NULL)
+  {
+    ret = ais2dw12_pipeline_push(pipe, NULL);
+    pipe->cur = ais2dw12_blk_alloc(pipe->pool);
+  }
+
+  if ((ret == 0) && (pipe->cur == NULL))
+  {
+    ret = -1;
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_stream_blk_get(ctx, pipe->stream, pipe->cur);
+  }
+
+  if ((ret == 0) && ((pipe->cur->len == pipe->cur->cap) ||
+                     ((pipe->cur->flags & AIS2DW12_BLK_CLOSED) != 0U)))
+  {
+    ret = ais2dw12_pipeline_push(pipe, pipe->cur);
+    pipe->cur = NULL;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Change the stream configuration through the pipeline. The
+  *         FIFO content is moved into the current block (allocated if
+  *         needed) and, when it is full, into an overflow block taken
+  *         from the pool; both are closed and published in order
+  *         before the new configuration is applied. Without a free
+  *         block for the overflow, the samples that don't fit are
+  *         dropped.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  pipe     pipeline
+  * @param  cfg      new configuration
+  * @retval          interface status (MANDATORY: return 0 -> no Error),
+  *                  -1 if the pool is exhausted or the configuration is
+  *                  not valid, otherwise first error returned by a
+  *                  synchronous stage
+  *
+  */
+int32_t ais2dw12_pipeline_reconfig(const stmdev_ctx_t *ctx,
+                                   ais2dw12_pipeline_t *pipe,
+                                   const ais2dw12_stream_cfg_t *cfg)
+{
+  ais2dw12_blk_t *ovf;
+  int32_t ret;
+  int32_t err;
+
+  ret = 0;
+
+  if (pipe->cur == NULL)
+  {
+    pipe->cur = ais2dw12_blk_alloc(pipe->pool);
+  }
+
+  if (pipe->cur == NULL)
+  {
+    ret = ais2dw12_pipeline_push(pipe, NULL);
+    pipe->cur = ais2dw12_blk_alloc(pipe->pool);
+  }
+
+  if ((ret == 0) && (pipe->cur == NULL))
+  {
+    ret = -1;
+  }
+
+  if (ret == 0)
+  {
+    ovf = ais2dw12_blk_alloc(pipe->pool);
+    ret = ais2dw12_stream_reconfig(ctx, pipe->stream, pipe->cur, ovf, cfg);
+
+    if ((pipe->cur->flags & AIS2DW12_BLK_CLOSED) != 0U)
+    {
+      err = ais2dw12_pipeline_push(pipe, pipe->cur);
+      pipe->cur = NULL;
+      ret = (ret == 0) ? err : ret;
+    }
+
+    if ((ovf != NULL) && (ovf->len > 0U))
+    {
+      err = ais2dw12_pipeline_push(pipe, ovf);
+      ret = (ret == 0) ? err : ret;
+    }
+
+    else if (ovf != NULL)
+    {
+      ais2dw12_blk_release(pipe->pool, ovf);
+    }
+
+    else
+    {
+      /* overflow samples dropped */
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Spectral_Analysis
+  * @brief     This section groups the functions that compute windowed
+  *            real FFT and Welch averaged power spectral density of a
+  *            stream, one state per axis. Twiddles and windows are
+  *            precomputed and all buffers are provided by the caller,
+  *            nothing is allocated per frame.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a real FFT of size n (power of two, 4 to 4096).
+  *
+  * @param  fft      FFT descriptor
+  * @param  twiddle  table of n elements (n / 2 complex twiddles)
+  * @param  n        FFT size
+  * @retval          0 -> no Error, -1 -> invalid size
+  *
+  */
+int32_t ais2dw12_fft_init(ais2dw12_fft_t *fft, float_t *twiddle,
+                          uint16_t n)
+{
+  uint16_t k;
+  int32_t ret;
+
+  if ((n < 4U) || (n > AIS2DW12_FFT_MAX) || ((n & (n - 1U)) != 0U))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    for (k = 0U; k < (n / 2U); k++)
+    {
+      twiddle[2U * k] = cosf(AIS2DW12_2PI * (float_t)k / (float_t)n);
+      twiddle[(2U * k) + 1U] = -sinf(AIS2DW12_2PI * (float_t)k /
+                                     (float_t)n);
+    }
+
+    fft->twiddle = twiddle;
+    fft->n = n;
+    ret = 0;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  In-place complex FFT of n / 2 points (interleaved re, im).
+  *
+  * @param  fft      FFT descriptor
+  * @param  buf      n elements
+  *
+  */
+void ais2dw12_cfft(const ais2dw12_fft_t *fft, float_t *buf)
+{
+  const float_t *tw;
+  uint16_t m;
+  uint16_t len;
+  uint16_t half;
+  uint16_t step;
+  uint16_t i;
+  uint16_t j;
+  uint16_t k;
+  uint16_t bit;
+  float_t tr;
+  float_t ti;
+  float_t vr;
+  float_t vi;
+
+  m = fft->n / 2U;
+  tw = fft->twiddle;
+
+  /* bit reversal permutation */
+  j = 0U;
+
+  for (i = 0U; i < m; i++)
+  {
+    if (i < j)
+    {
+      tr = buf[2U * i];
+      ti = buf[(2U * i) + 1U];
+      buf[2U * i] = buf[2U * j];
+      buf[(2U * i) + 1U] = buf[(2U * j) + 1U];
+      buf[2U * j] = tr;
+      buf[(2U * j) + 1U] = ti;
+    }
+
+    bit = m >> 1;
+
+    while ((bit > 0U) && ((j & bit) != 0U))
+    {
+      j ^= bit;
+      bit >>= 1;
+    }
+
+    j |= bit;
+  }
+
+  /* radix-2 butterflies, twiddles taken from the n-point table */
+  for (len = 2U; len <= m; len <<= 1)
+  {
+    half = len / 2U;
+    step = fft->n / len;
+
+    for (i = 0U; i < m; i += len)
+    {
+      for (k = 0U; k < half; k++)
+      {
+        tr = tw[2U * k * step];
+        ti = tw[(2U * k * step) + 1U];
+        j = (uint16_t)(2U * (i + k + half));
+        vr = (buf[j] * tr) - (buf[j + 1U] * ti);
+        vi = (buf[j] * ti) + (buf[j + 1U] * tr);
+        buf[j] = buf[2U * (i + k)] - vr;
+        buf[j + 1U] = buf[(2U * (i + k)) + 1U] - vi;
+        buf[2U * (i + k)] += vr;
+        buf[(2U * (i + k)) + 1U] += vi;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  In-place real FFT of n points. On output buf[0] is the DC
+  *         bin, buf[1] the Nyquist bin (both real) and buf[2k],
+  *         buf[2k + 1] are re, im of bin k, 0 < k < n / 2.
+  *
+  * @param  fft      FFT descriptor
+  * @param  buf      n elements
+  *
+  */
+void ais2dw12_rfft(const ais2dw12_fft_t *fft, float_t *buf)
+{
+  uint16_t m;
+  uint16_t k;
+  float_t er;
+  float_t ei;
+  float_t xr;
+  float_t xi;
+  float_t tr;
+  float_t ti;
+  float_t wr;
+  float_t wi;
+
+  m = fft->n / 2U;
+  ais2dw12_cfft(fft, buf);
+
+  er = buf[0];
+  buf[0] = er + buf[1];
+  buf[1] = er - buf[1];
+
+  for (k = 1U; k <= (m / 2U); k++)
+  {
+    /* even / odd part: Z[k] and conj(Z[m - k]) */
+    er = 0.5f * (buf[2U * k] + buf[2U * (m - k)]);
+    ei = 0.5f * (buf[(2U * k) + 1U] - buf[(2U * (m - k)) + 1U]);
+    xr = 0.5f * (buf[(2U * k) + 1U] + buf[(2U * (m - k)) + 1U]);
+    xi = -0.5f * (buf[2U * k] - buf[2U * (m - k)]);
+    wr = fft->twiddle[2U * k];
+    wi = fft->twiddle[(2U * k) + 1U];
+    tr = (wr * xr) - (wi * xi);
+    ti = (wr * xi) + (wi * xr);
+    buf[2U * k] = er + tr;
+    buf[(2U * k) + 1U] = ei + ti;
+    buf[2U * (m - k)] = er - tr;
+    buf[(2U * (m - k)) + 1U] = -(ei - ti);
+  }
+}
+
+/**
+  * @brief  Fill a window of n points.
+  *
+  * @param  win      window buffer (n elements)
+  * @param  n        window size
+  * @param  type     window type
+  *
+  */
+void ais2dw12_window_init(float_t *win, uint16_t n, ais2dw12_win_t type)
+{
+  float_t a;
+  uint16_t i;
+
+  for (i = 0U; i < n; i++)
+  {
+    a = AIS2DW12_2PI * (float_t)i / (float_t)n;
+
+    if (type == AIS2DW12_WIN_FLAT_TOP)
+    {
+      win[i] = 0.21557895f - (0.41663158f * cosf(a)) +
+               (0.277263158f * cosf(2.0f * a)) -
+               (0.083578947f * cosf(3.0f * a)) +
+               (0.006947368f * cosf(4.0f * a));
+    }
+
+    else
+    {
+      win[i] = 0.5f - (0.5f * cosf(a));
+    }
+  }
+}
+
+/**
+  * @brief  Initialize a Welch PSD state.
+  *
+  * @param  psd      PSD state
+  * @param  fft      FFT descriptor (may be shared)
+  * @param  win      window of fft->n points (may be shared)
+  * @param  frame    frame buffer of fft->n elements
+  * @param  work     FFT work buffer of fft->n elements (may be shared
+  *                  among states processed by the same thread)
+  * @param  out      averaged PSD, fft->n / 2 + 1 bins in unit^2 / Hz
+  * @param  hop      samples between two frames (fft->n / 2 -> 50%
+  *                  overlap)
+  * @param  odr_hz   sample rate in Hz
+  * @param  max_avg  frames in the average, then exponential average
+  *                  (0 -> cumulative average)
+  *
+  */
+void ais2dw12_psd_init(ais2dw12_psd_t *psd, const ais2dw12_fft_t *fft,
+                       const float_t *win, float_t *frame, float_t *work,
+                       float_t *out, uint16_t hop, float_t odr_hz,
+                       uint32_t max_avg)
+{
+  float_t sum;
+  uint16_t i;
+
+  sum = 0.0f;
+
+  for (i = 0U; i < fft->n; i++)
+  {
+    sum += win[i] * win[i];
+  }
+
+  for (i = 0U; i <= (fft->n / 2U); i++)
+  {
+    out[i] = 0.0f;
+  }
+
+  psd->fft = fft;
+  psd->win = win;
+  psd->frame = frame;
+  psd->work = work;
+  psd->out = out;
+  psd->hop = ((hop == 0U) || (hop > fft->n)) ? fft->n : hop;
+  psd->fill = 0U;
+  psd->avg = 0U;
+  psd->max_avg = max_avg;
+  psd->norm = 1.0f / (odr_hz * sum);
+}
+
+/**
+  * @brief  Feed samples to a Welch PSD state. A windowed FFT is run and
+  *         averaged in every time a frame is complete.
+  *
+  * @param  psd      PSD state
+  * @param  x        samples
+  * @param  len      number of samples
+  * @retval          number of frames averaged in by this call
+  *
+  */
+uint16_t ais2dw12_psd_update(ais2dw12_psd_t *psd, const float_t *x,
+                             uint16_t len)
+{
+  const ais2dw12_fft_t *fft;
+  float_t *w;
+  float_t p;
+  float_t g;
+  uint16_t frames;
+  uint16_t m;
+  uint16_t i;
+  uint16_t k;
+
+  fft = psd->fft;
+  w = psd->work;
+  m = fft->n / 2U;
+  frames = 0U;
+
+  for (i = 0U; i < len; i++)
+  {
+    psd->frame[psd->fill] = x[i];
+    psd->fill++;
+
+    if (psd->fill == fft->n)
+    {
+      for (k = 0U; k < fft->n; k++)
+      {
+        w[k] = psd->frame[k] * psd->win[k];
+      }
+
+      ais2dw12_rfft(fft, w);
+
+      if ((psd->max_avg == 0U) || (psd->avg < psd->max_avg))
+      {
+        psd->avg++;
+      }
+
+      g = 1.0f / (float_t)psd->avg;
+
+      p = w[0] * w[0] * psd->norm;
+      psd->out[0] += g * (p - psd->out[0]);
+      p = w[1] * w[1] * psd->norm;
+      psd->out[m] += g * (p - psd->out[m]);
+
+      for (k = 1U; k < m; k++)
+      {
+        p = 2.0f * psd->norm * ((w[2U * k] * w[2U * k]) +
+                                (w[(2U * k) + 1U] * w[(2U * k) + 1U]));
+        psd->out[k] += g * (p - psd->out[k]);
+      }
+
+      for (k = psd->hop; k < fft->n; k++)
+      {
+        psd->frame[k - psd->hop] = psd->frame[k];
+      }
+
+      psd->fill = fft->n - psd->hop;
+      frames++;
+    }
+  }
+
+  return frames;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Statistics
+  * @brief     This section groups the functions that keep running
+  *            per-axis vibration statistics (mean, RMS, peak,
+  *            peak-to-peak, crest factor, skewness, kurtosis) over
+  *            tumbling or sliding windows, with O(1) work per sample.
+  *            A state covers the 3 axes of one device: the per-sample
+  *            work is branchy (extremes queues), so devices are not
+  *            packed in lanes, use one state per device.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize tumbling window statistics.
+  *
+  * @param  st       statistics state
+  * @param  win      window length in samples
+  *
+  */
+void ais2dw12_stats_init(ais2dw12_stats_t *st, uint32_t win)
+{
+  uint8_t a;
+
+  st->win = win;
+  st->n = 0U;
+
+  for (a = 0U; a < 3U; a++)
+  {
+    st->mean[a] = 0.0f;
+    st->m2[a] = 0.0f;
+    st->m3[a] = 0.0f;
+    st->m4[a] = 0.0f;
+    st->min[a] = 0.0f;
+    st->max[a] = 0.0f;
+  }
+}
+
+/**
+  * @brief  Update tumbling window statistics (numerically stable one-pass
+  *         central moments). A result is produced each time a window is
+  *         complete.
+  *
+  * @param  st       statistics state
+  * @param  x        X-axis samples
+  * @param  y        Y-axis samples
+  * @param  z        Z-axis samples
+  * @param  len      number of samples
+  * @param  out      results, one per completed window
+  * @param  max_out  size of out; further windows overwrite the last one
+  * @retval          number of completed windows
+  *
+  */
+uint16_t ais2dw12_stats_update(ais2dw12_stats_t *st, const float_t *x,
+                               const float_t *y, const float_t *z,
+                               uint16_t len, ais2dw12_stats_out_t *out,
+                               uint16_t max_out)
+{
+  const float_t *in[3];
+  float_t n;
+  float_t n1;
+  float_t v;
+  float_t d;
+  float_t dn;
+  float_t dn2;
+  float_t t;
+  uint16_t cnt;
+  uint16_t i;
+  uint8_t a;
+
+  in[0] = x;
+  in[1] = y;
+  in[2] = z;
+  cnt = 0U;
+
+  for (i = 0U; i < len; i++)
+  {
+    n1 = (float_t)st->n;
+    st->n++;
+    n = (float_t)st->n;
+
+    for (a = 0U; a < 3U; a++)
+    {
+      v = in[a][i];
+      d = v - st->mean[a];
+      dn = d / n;
+      dn2 = dn * dn;
+      t = d * dn * n1;
+      st->mean[a] += dn;
+      st->m4[a] += (t * dn2 * ((n * n) - (3.0f * n) + 3.0f)) +
+                   (6.0f * dn2 * st->m2[a]) - (4.0f * dn * st->m3[a]);
+      st->m3[a] += (t * dn * (n - 2.0f)) - (3.0f * dn * st->m2[a]);
+      st->m2[a] += t;
+
+      if ((st->n == 1U) || (v < st->min[a]))
+      {
+        st->min[a] = v;
+      }
+
+      if ((st->n == 1U) || (v > st->max[a]))
+      {
+        st->max[a] = v;
+      }
+    }
+
+    if (st->n >= st->win)
+    {
+      if (max_out > 0U)
+      {
+        for (a = 0U; a < 3U; a++)
+        {
+          stats_out_set(&out[(cnt < max_out) ? cnt : (max_out - 1U)], a, n,
+                        st->mean[a], st->m2[a], st->m3[a], st->m4[a],
+                        st->min[a], st->max[a]);
+        }
+      }
+
+      cnt++;
+      ais2dw12_stats_init(st, st->win);
+    }
+  }
+
+  return cnt;
+}
+
+/**
+  * @brief  Initialize sliding window statistics.
+  *
+  * @param  st       statistics state
+  * @param  buf      sample history, 3 * win elements
+  * @param  dq       extremes queues, 6 * win elements
+  * @param  win      window length in samples (not 0)
+  * @retval          0 -> no Error, -1 -> invalid window length
+  *
+  */
+int32_t ais2dw12_stats_sl_init(ais2dw12_stats_sl_t *st, float_t *buf,
+                               uint32_t *dq, uint16_t win)
+{
+  uint8_t a;
+  uint8_t j;
+  int32_t ret;
+
+  if (win == 0U)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    st->buf = buf;
+    st->dq = dq;
+    st->win = win;
+    st->n = 0U;
+    st->pos = 0U;
+    st->cnt = 0U;
+    st->rebase = 0U;
+
+    for (a = 0U; a < 3U; a++)
+    {
+      st->k[a] = 0.0f;
+
+      for (j = 0U; j < 4U; j++)
+      {
+        st->s[a][j] = 0.0f;
+      }
+
+      for (j = 0U; j < 2U; j++)
+      {
+        st->head[a][j] = 0U;
+        st->tail[a][j] = 0U;
+      }
+    }
+
+    ret = 0;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Update sliding window statistics. Power sums are kept around
+  *         a reference value which is moved to the window mean once per
+  *         window length, so rounding errors don't accumulate; minimum
+  *         and maximum are tracked with monotonic queues.
+  *
+  * @param  st       statistics state
+  * @param  x        X-axis samples
+  * @param  y        Y-axis samples
+  * @param  z        Z-axis samples
+  * @param  len      number of samples
+  *
+  */
+void ais2dw12_stats_sl_update(ais2dw12_stats_sl_t *st, const float_t *x,
+                              const float_t *y, const float_t *z,
+                              uint16_t len)
+{
+  const float_t *in[3];
+  uint32_t *q;
+  float_t *buf;
+  float_t d;
+  float_t d2;
+  float_t v;
+  uint16_t w;
+  uint16_t i;
+  uint8_t a;
+  uint8_t j;
+
+  in[0] = x;
+  in[1] = y;
+  in[2] = z;
+  w = st->win;
+
+  for (i = 0U; i < len; i++)
+  {
+    for (a = 0U; a < 3U; a++)
+    {
+      buf = &st->buf[a * w];
+      v = in[a][i];
+
+      if (st->n == w)
+      {
+        d = buf[st->pos] - st->k[a];
+        d2 = d * d;
+        st->s[a][0] -= d;
+        st->s[a][1] -= d2;
+        st->s[a][2] -= d2 * d;
+        st->s[a][3] -= d2 * d2;
+      }
+
+      buf[st->pos] = v;
+      d = v - st->k[a];
+      d2 = d * d;
+      st->s[a][0] += d;
+      st->s[a][1] += d2;
+      st->s[a][2] += d2 * d;
+      st->s[a][3] += d2 * d2;
+
+      /* j = 0: decreasing queue (max), j = 1: increasing queue (min) */
+      for (j = 0U; j < 2U; j++)
+      {
+        q = &st->dq[((2U * a) + j) * w];
+
+        while ((st->head[a][j] != st->tail[a][j]) &&
+               ((st->cnt - q[st->head[a][j] % w]) >= w))
+        {
+          st->head[a][j]++;
+        }
+
+        while ((st->head[a][j] != st->tail[a][j]) &&
+               (((j == 0U) &&
+                 (buf[q[(st->tail[a][j] - 1U) % w] % w] <= v)) ||
+                ((j == 1U) &&
+                 (buf[q[(st->tail[a][j] - 1U) % w] % w] >= v))))
+        {
+          st->tail[a][j]--;
+        }
+
+        q[st->tail[a][j] % w] = st->cnt;
+        st->tail[a][j]++;
+      }
+    }
+
+    st->cnt++;
+    st->pos = (uint16_t)((st->pos + 1U) % w);
+
+    if (st->n < w)
+    {
+      st->n++;
+    }
+
+    st->rebase++;
+
+    if (st->rebase >= w)
+    {
+      st->rebase = 0U;
+
+      for (a = 0U; a < 3U; a++)
+      {
+        stats_sl_rebase(st, a);
+      }
+
+      /* keep the sample counter far from wrap-around */
+      if (st->cnt >= 0x80000000U)
+      {
+        stats_sl_renumber(st, ((st->cnt / w) - 1U) * w);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Statistics of the samples in the sliding window.[get]
+  *
+  * @param  st       statistics state
+  * @param  out      results
+  *
+  */
+void ais2dw12_stats_sl_get(const ais2dw12_stats_sl_t *st,
+                           ais2dw12_stats_out_t *out)
+{
+  const uint32_t *q;
+  const float_t *buf;
+  float_t n;
+  float_t m1;
+  float_t m2;
+  float_t m3;
+  float_t m4;
+  float_t ext[2];
+  uint8_t a;
+  uint8_t j;
+
+  n = (st->n > 0U) ? (float_t)st->n : 1.0f;
+
+  for (a = 0U; a < 3U; a++)
+  {
+    buf = &st->buf[a * st->win];
+    m1 = st->s[a][0] / n;
+    m2 = st->s[a][1] / n;
+    m3 = st->s[a][2] / n;
+    m4 = st->s[a][3] / n;
+
+    for (j = 0U; j < 2U; j++)
+    {
+      q = &st->dq[((2U * a) + j) * st->win];
+      ext[j] = (st->head[a][j] != st->tail[a][j]) ?
+               buf[q[st->head[a][j] % st->win] % st->win] : 0.0f;
+    }
+
+    /* central moments from the moments around the reference */
+    stats_out_set(out, a, n, st->k[a] + m1,
+                  n * (m2 - (m1 * m1)),
+                  n * (m3 - (3.0f * m1 * m2) + (2.0f * m1 * m1 * m1)),
+                  n * (m4 - (4.0f * m1 * m3) + (6.0f * m1 * m1 * m2) -
+                       (3.0f * m1 * m1 * m1 * m1)),
+                  ext[1], ext[0]);
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Tilt
+  * @brief     This section groups the functions that compute pitch, roll
+  *            and inclination angles from blocks of samples.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Compute pitch, roll and inclination (angle between Z-axis and
+  *         gravity) in degrees. A bounded error atan2 is used (error
+  *         below 2e-6 rad, i.e. 1.2e-4 deg). Samples can be averaged in groups of
+  *         cfg->avg before the angles are computed, and a bias
+  *         depending on temperature can be removed:
+  *         bias = cfg->bias + cfg->bias_tc * (temp_c - cfg->t0).
+  *
+  * @param  x        X-axis samples (mg)
+  * @param  y        Y-axis samples (mg)
+  * @param  z        Z-axis samples (mg)
+  * @param  len      number of samples
+  * @param  cfg      averaging and bias settings (NULL -> none)
+  * @param  temp_c   sensor temperature in degC
+  * @param  pitch    pitch output, may be NULL (len / avg elements)
+  * @param  roll     roll output, may be NULL (len / avg elements)
+  * @param  incl     inclination output, may be NULL (len / avg elements)
+  * @retval          number of angles computed
+  *
+  */
+uint16_t ais2dw12_tilt_get(const float_t *x, const float_t *y,
+                           const float_t *z, uint16_t len,
+                           const ais2dw12_tilt_cfg_t *cfg, float_t temp_c,
+                           float_t *pitch, float_t *roll, float_t *incl)
+{
+  float_t b[3];
+  float_t ax;
+  float_t ay;
+  float_t az;
+  float_t k;
+  uint16_t avg;
+  uint16_t out;
+  uint16_t i;
+  uint16_t j;
+  uint8_t a;
+
+  avg = ((cfg != NULL) && (cfg->avg > 1U)) ? cfg->avg : 1U;
+  k = 1.0f / (float_t)avg;
+
+  for (a = 0U; a < 3U; a++)
+  {
+    b[a] = (cfg != NULL) ? (cfg->bias[a] +
+                            (cfg->bias_tc[a] * (temp_c - cfg->t0))) : 0.0f;
+  }
+
+  out = 0U;
+
+  for (i = 0U; (i + avg) <= len; i += avg)
+  {
+    ax = 0.0f;
+    ay = 0.0f;
+    az = 0.0f;
+
+    for (j = i; j < (i + avg); j++)
+    {
+      ax += x[j];
+      ay += y[j];
+      az += z[j];
+    }
+
+    ax = (ax * k) - b[0];
+    ay = (ay * k) - b[1];
+    az = (az * k) - b[2];
+
+    if (pitch != NULL)
+    {
+      pitch[out] = AIS2DW12_RAD_TO_DEG *
+                   fast_atan2(-ax, sqrtf((ay * ay) + (az * az)));
+    }
+
+    if (roll != NULL)
+    {
+      roll[out] = AIS2DW12_RAD_TO_DEG * fast_atan2(ay, az);
+    }
+
+    if (incl != NULL)
+    {
+      incl[out] = AIS2DW12_RAD_TO_DEG *
+                  fast_atan2(sqrtf((ax * ax) + (ay * ay)), az);
+    }
+
+    out++;
+  }
+
+  return out;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Six_Position_Host
+  * @brief     This section groups the functions that run the 6D/4D
+  *            orientation detection on streamed or recorded samples,
+  *            with the same threshold semantics of SIXD_THS, so that no
+  *            SIXD_SRC read is needed.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the host 6D/4D detector.
+  *
+  * @param  st       detector state
+  * @param  ths      threshold, same coding of ais2dw12_6d_threshold_set
+  *                  (0 -> 80 deg, 1 -> 70 deg, 2 -> 60 deg, 3 -> 50 deg)
+  * @param  _4d_en   same meaning of ais2dw12_4d_mode_set (Z-axis
+  *                  position detection disabled)
+  *
+  */
+void ais2dw12_6d_host_init(ais2dw12_6d_host_t *st, uint8_t ths,
+                           uint8_t _4d_en)
+{
+  /* 1 g * sin(threshold angle) */
+  const float_t ths_mg[4] = { 984.8f, 939.7f, 866.0f, 766.0f };
+
+  st->ths_mg = ths_mg[ths & 0x03U];
+  st->_4d_en = _4d_en;
+  st->pos = 0U;
+}
+
+/**
+  * @brief  Run the host 6D/4D detector on a block of samples. A
+  *         position is reported when the acceleration along an axis
+  *         exceeds the threshold; an event (_6d_ia) is generated each
+  *         time the position changes, as for the embedded function.
+  *
+  * @param  st       detector state
+  * @param  x        X-axis samples (mg)
+  * @param  y        Y-axis samples (mg)
+  * @param  z        Z-axis samples (mg)
+  * @param  len      number of samples
+  * @param  src      per sample SIXD_SRC image, may be NULL (len elements)
+  * @param  pos      SIXD_SRC image of the last position, may be NULL
+  * @retval          number of position change events
+  *
+  */
+uint16_t ais2dw12_6d_host_run(ais2dw12_6d_host_t *st, const float_t *x,
+                              const float_t *y, const float_t *z,
+                              uint16_t len, ais2dw12_sixd_src_t *src,
+                              ais2dw12_sixd_src_t *pos)
+{
+  float_t t;
+  uint16_t cnt;
+  uint16_t i;
+  uint8_t reg;
+
+  t = st->ths_mg;
+  cnt = 0U;
+
+  for (i = 0U; i < len; i++)
+  {
+    reg = (x[i] < -t) ? 0x01U : 0x00U;
+    reg |= (x[i] > t) ? 0x02U : 0x00U;
+    reg |= (y[i] < -t) ? 0x04U : 0x00U;
+    reg |= (y[i] > t) ? 0x08U : 0x00U;
+
+    if (st->_4d_en == PROPERTY_DISABLE)
+    {
+      reg |= (z[i] < -t) ? 0x10U : 0x00U;
+      reg |= (z[i] > t) ? 0x20U : 0x00U;
+    }
+
+    if ((reg != 0U) && (reg != st->pos))
+    {
+      st->pos = reg;
+      reg |= 0x40U;
+      cnt++;
+    }
+
+    if (src != NULL)
+    {
+      bytecpy((uint8_t *)&src[i], &reg);
+    }
+  }
+
+  if (pos != NULL)
+  {
+    bytecpy((uint8_t *)pos, &st->pos);
+  }
+
+  return cnt;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Wake_Up_Free_Fall_Host
+  * @brief     This section groups the functions that run the wake-up and
+  *            free-fall detection on streamed or recorded samples. The
+  *            parameters have the same coding of the related registers,
+  *            so a setting tuned offline can be written unchanged with
+  *            ais2dw12_wkup_threshold_set, ais2dw12_wkup_dur_set,
+  *            ais2dw12_ff_threshold_set and ais2dw12_ff_dur_set.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the host wake-up detector.
+  *
+  * @param  st       detector state
+  * @param  fs       full scale (wk_ths 1 LSb = FS / 64)
+  * @param  wk_ths   wake-up threshold, WAKE_UP_THS coding (6 bit)
+  * @param  wake_dur wake-up duration, WAKE_UP_DUR coding (1 LSb = 1 / ODR)
+  * @param  feed     AIS2DW12_HP_FEED: slope filter data, as the embedded
+  *                  function; AIS2DW12_USER_OFFSET_FEED: samples as they
+  *                  are
+  *
+  */
+void ais2dw12_wkup_host_init(ais2dw12_wkup_host_t *st, ais2dw12_fs_t fs,
+                             uint8_t wk_ths, uint8_t wake_dur,
+                             ais2dw12_usr_off_on_wu_t feed)
+{
+  st->ths_mg = (float_t)(wk_ths & 0x3FU) *
+               ((fs == AIS2DW12_4g) ? 62.5f : 31.25f);
+  st->dur = wake_dur & 0x03U;
+  st->feed = feed;
+  st->cnt = 0U;
+  st->init = PROPERTY_DISABLE;
+  st->prev[0] = 0.0f;
+  st->prev[1] = 0.0f;
+  st->prev[2] = 0.0f;
+}
+
+/**
+  * @brief  Run the host wake-up detector on a block of samples. An event
+  *         is generated when at least one axis exceeds the threshold for
+  *         more than wake_dur samples.
+  *
+  * @param  st       detector state
+  * @param  x        X-axis samples (mg)
+  * @param  y        Y-axis samples (mg)
+  * @param  z        Z-axis samples (mg)
+  * @param  len      number of samples
+  * @param  evt      indexes of the samples generating an event, may be
+  *                  NULL
+  * @param  max_evt  size of evt
+  * @retval          number of events
+  *
+  */
+uint16_t ais2dw12_wkup_host_run(ais2dw12_wkup_host_t *st, const float_t *x,
+                                const float_t *y, const float_t *z,
+                                uint16_t len, uint16_t *evt,
+                                uint16_t max_evt)
+{
+  float_t d[3];
+  uint16_t num;
+  uint16_t i;
+  uint8_t over;
+
+  num = 0U;
+
+  for (i = 0U; i < len; i++)
+  {
+    if (st->feed == AIS2DW12_HP_FEED)
+    {
+      if (st->init == PROPERTY_DISABLE)
+      {
+        st->prev[0] = x[i];
+        st->prev[1] = y[i];
+        st->prev[2] = z[i];
+        st->init = PROPERTY_ENABLE;
+      }
+
+      /* slope filter */
+      d[0] = 0.5f * (x[i] - st->prev[0]);
+      d[1] = 0.5f * (y[i] - st->prev[1]);
+      d[2] = 0.5f * (z[i] - st->prev[2]);
+      st->prev[0] = x[i];
+      st->prev[1] = y[i];
+      st->prev[2] = z[i];
+    }
+
+    else
+    {
+      d[0] = x[i];
+      d[1] = y[i];
+      d[2] = z[i];
+    }
+
+    over = ((fabsf(d[0]) > st->ths_mg) || (fabsf(d[1]) > st->ths_mg) ||
+            (fabsf(d[2]) > st->ths_mg)) ? PROPERTY_ENABLE : PROPERTY_DISABLE;
+
+    if (over == PROPERTY_DISABLE)
+    {
+      st->cnt = 0U;
+    }
+
+    else if (st->cnt <= st->dur)
+    {
+      st->cnt++;
+
+      if (st->cnt > st->dur)
+      {
+        if ((evt != NULL) && (num < max_evt))
+        {
+          evt[num] = i;
+        }
+
+        num++;
+      }
+    }
+
+    else
+    {
+      /* event already notified */
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @brief  Initialize the host free-fall detector.
+  *
+  * @param  st       detector state
+  * @param  ff_ths   free-fall threshold, FREE_FALL coding
+  * @param  ff_dur   free-fall duration, same coding of ais2dw12_ff_dur_set
+  *                  (6 bit, 1 LSb = 1 / ODR)
+  *
+  */
+void ais2dw12_ff_host_init(ais2dw12_ff_host_t *st, ais2dw12_ff_ths_t ff_ths,
+                           uint8_t ff_dur)
+{
+  /* ff_ths in LSb at FS = 2 g, 1 LSb = 31.25 mg */
+  const uint8_t ths_lsb[8] = { 5U, 7U, 8U, 10U, 11U, 13U, 15U, 16U };
+
+  st->ths_mg = (float_t)ths_lsb[(uint8_t)ff_ths & 0x07U] * 31.25f;
+  st->dur = ff_dur & 0x3FU;
+  st->cnt = 0U;
+}
+
+/**
+  * @brief  Run the host free-fall detector on a block of samples. An
+  *         event is generated when all the axes stay below the threshold
+  *         for more than ff_dur samples.
+  *
+  * @param  st       detector state
+  * @param  x        X-axis samples (mg)
+  * @param  y        Y-axis samples (mg)
+  * @param  z        Z-axis samples (mg)
+  * @param  len      number of samples
+  * @param  evt      indexes of the samples generating an event, may be
+  *                  NULL
+  * @param  max_evt  size of evt
+  * @retval          number of events
+  *
+  */
+uint16_t ais2dw12_ff_host_run(ais2dw12_ff_host_t *st, const float_t *x,
+                              const float_t *y, const float_t *z,
+                              uint16_t len, uint16_t *evt,
+                              uint16_t max_evt)
+{
+  uint16_t num;
+  uint16_t i;
+
+  num = 0U;
+
+  for (i = 0U; i < len; i++)
+  {
+    if ((fabsf(x[i]) >= st->ths_mg) || (fabsf(y[i]) >= st->ths_mg) ||
+        (fabsf(z[i]) >= st->ths_mg))
+    {
+      st->cnt = 0U;
+    }
+
+    else if (st->cnt <= st->dur)
+    {
+      st->cnt++;
+
+      if (st->cnt > st->dur)
+      {
+        if ((evt != NULL) && (num < max_evt))
+        {
+          evt[num] = i;
+        }
+
+        num++;
+      }
+    }
+
+    else
+    {
+      /* event already notified */
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Decimation
+  * @brief     This section groups the functions that decimate the stream
+  *            with a CIC filter followed by a 3-tap droop compensation
+  *            FIR, to trade output rate for noise.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a decimator.
+  *
+  * @param  st       decimator state
+  * @param  order    CIC order (1 to AIS2DW12_CIC_MAX_ORDER)
+  * @param  ratio    decimation ratio; ratio^order must not exceed 65536
+  * @param  comp     compensation coefficient a of FIR [-a, 1 + 2a, -a]
+  *                  at output rate (0 -> no compensation)
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t ais2dw12_decim_init(ais2dw12_decim_t *st, uint8_t order,
+                            uint16_t ratio, float_t comp)
+{
+  uint32_t gain;
+  uint8_t a;
+  uint8_t i;
+  int32_t ret;
+
+  gain = 1U;
+
+  for (i = 0U; (i < order) && (gain <= 65536U); i++)
+  {
+    gain *= ratio;
+  }
+
+  if ((order == 0U) || (order > AIS2DW12_CIC_MAX_ORDER) || (ratio == 0U) ||
+      (gain > 65536U))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    st->order = order;
+    st->ratio = ratio;
+    st->phase = 0U;
+    st->comp = comp;
+    st->norm = 1.0f / (float_t)gain;
+    st->fill = 0U;
+
+    for (a = 0U; a < 3U; a++)
+    {
+      for (i = 0U; i < AIS2DW12_CIC_MAX_ORDER; i++)
+      {
+        st->integ[a][i] = 0U;
+        st->comb[a][i] = 0U;
+      }
+
+      st->hist[a][0] = 0.0f;
+      st->hist[a][1] = 0.0f;
+    }
+
+    ret = 0;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Decimate a raw sample block. CIC stages run on integers with
+  *         modulo 2^32 arithmetic, which is exact thanks to the bit
+  *         growth limit checked at init; output is in mg.
+  *
+  * @param  st       decimator state
+  * @param  blk      raw sample block (full scale taken from blk->fs)
+  * @param  x        X-axis output (blk->len / ratio + 1 elements)
+  * @param  y        Y-axis output (blk->len / ratio + 1 elements)
+  * @param  z        Z-axis output (blk->len / ratio + 1 elements)
+  * @retval          number of output samples
+  *
+  */
+uint16_t ais2dw12_decim_run(ais2dw12_decim_t *st, const ais2dw12_blk_t *blk,
+                            float_t *x, float_t *y, float_t *z)
+{
+  const int16_t *in[3];
+  float_t *out[3];
+  float_t sens;
+  float_t v;
+  uint32_t acc;
+  uint32_t tmp;
+  uint16_t num;
+  uint16_t i;
+  uint8_t a;
+  uint8_t j;
+
+  in[0] = blk->x;
+  in[1] = blk->y;
+  in[2] = blk->z;
+  out[0] = x;
+  out[1] = y;
+  out[2] = z;
+  sens = fs_sens(blk->fs) * st->norm;
+  num = 0U;
+
+  for (i = 0U; i < blk->len; i++)
+  {
+    for (a = 0U; a < 3U; a++)
+    {
+      acc = (uint32_t)(int32_t)in[a][i];
+
+      for (j = 0U; j < st->order; j++)
+      {
+        st->integ[a][j] += acc;
+        acc = st->integ[a][j];
+      }
+    }
+
+    st->phase++;
+
+    if (st->phase >= st->ratio)
+    {
+      st->phase = 0U;
+
+      for (a = 0U; a < 3U; a++)
+      {
+        acc = st->integ[a][st->order - 1U];
+
+        for (j = 0U; j < st->order; j++)
+        {
+          tmp = acc - st->comb[a][j];
+          st->comb[a][j] = acc;
+          acc = tmp;
+        }
+
+        v = (float_t)(int32_t)acc * sens;
+
+        if (st->comp != 0.0f)
+        {
+          /* FIR output is delayed by one output sample */
+          out[a][num] = ((1.0f + (2.0f * st->comp)) * st->hist[a][1]) -
+                        (st->comp * (st->hist[a][0] + v));
+          st->hist[a][0] = st->hist[a][1];
+          st->hist[a][1] = v;
+        }
+
+        else
+        {
+          out[a][num] = v;
+        }
+      }
+
+      if (st->fill < 2U)
+      {
+        st->fill++;
+      }
+
+      if ((st->comp == 0.0f) || (st->fill >= 2U))
+      {
+        num++;
+      }
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @brief  Noise at the output of the decimator for a white input noise,
+  *         computed by integrating the squared filter response.[get]
+  *
+  * @param  st       decimator state
+  * @param  nd_in    input noise density (e.g. ug / sqrt(Hz))
+  * @param  odr_in   input data rate in Hz
+  * @param  rms_out  output RMS noise (unit of nd_in * sqrt(Hz))
+  * @param  nd_out   effective output noise density, output RMS noise
+  *                  over the output Nyquist band (unit of nd_in)
+  *
+  */
+void ais2dw12_decim_noise_get(const ais2dw12_decim_t *st, float_t nd_in,
+                              float_t odr_in, float_t *rms_out,
+                              float_t *nd_out)
+{
+  float_t gain;
+  float_t h;
+  float_t w;
+  float_t sr;
+  float_t s;
+  uint32_t steps;
+  uint32_t i;
+  uint8_t j;
+
+  steps = 64U * (uint32_t)st->ratio;
+  gain = 0.0f;
+
+  /* mean of |H(w)|^2 on [0, pi] = sum of squared impulse response */
+  for (i = 0U; i < steps; i++)
+  {
+    w = 3.14159265f * ((float_t)i + 0.5f) / (float_t)steps;
+    s = sinf(0.5f * w);
+    sr = sinf(0.5f * w * (float_t)st->ratio);
+    h = (s != 0.0f) ? (sr / ((float_t)st->ratio * s)) : 1.0f;
+    sr = h;
+
+    for (j = 1U; j < st->order; j++)
+    {
+      h *= sr;
+    }
+
+    h *= (1.0f + (2.0f * st->comp)) -
+         (2.0f * st->comp * cosf(w * (float_t)st->ratio));
+    gain += h * h;
+  }
+
+  gain /= (float_t)steps;
+  *rms_out = nd_in * sqrtf(0.5f * odr_in * gain);
+  *nd_out = *rms_out / sqrtf(0.5f * odr_in / (float_t)st->ratio);
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Biquad
+  * @brief     This section groups the functions that run a cascade of
+  *            biquad IIR sections (transposed direct form II) on many
+  *            channels (lanes, e.g. axes of several devices) at once.
+  *            Samples are stored frame by frame ([sample][lane]) and
+  *            coefficients lane by lane, so the inner loop runs over
+  *            contiguous lanes and can be vectorized by the compiler.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Design a biquad section (bilinear transform with frequency
+  *         pre-warping).
+  *
+  * @param  coef     section coefficients
+  * @param  type     filter type
+  * @param  fc       center / cut-off frequency in Hz
+  * @param  q        quality factor (0.7071 -> Butterworth low / high pass)
+  * @param  odr_hz   sample rate in Hz
+  *
+  */
+void ais2dw12_biquad_design(ais2dw12_biquad_coef_t *coef,
+                            ais2dw12_biquad_type_t type, float_t fc,
+                            float_t q, float_t odr_hz)
+{
+  float_t w;
+  float_t cw;
+  float_t al;
+  float_t a0;
+
+  w = AIS2DW12_2PI * fc / odr_hz;
+  cw = cosf(w);
+  al = sinf(w) / (2.0f * q);
+  a0 = 1.0f + al;
+
+  switch (type)
+  {
+    case AIS2DW12_BIQUAD_HIGH_PASS:
+      coef->b0 = 0.5f * (1.0f + cw);
+      coef->b1 = -(1.0f + cw);
+      coef->b2 = coef->b0;
+      break;
+
+    case AIS2DW12_BIQUAD_BAND_PASS:
+      coef->b0 = al;
+      coef->b1 = 0.0f;
+      coef->b2 = -al;
+      break;
+
+    case AIS2DW12_BIQUAD_NOTCH:
+      coef->b0 = 1.0f;
+      coef->b1 = -2.0f * cw;
+      coef->b2 = 1.0f;
+      break;
+
+    case AIS2DW12_BIQUAD_LOW_PASS:
+    default:
+      coef->b0 = 0.5f * (1.0f - cw);
+      coef->b1 = 1.0f - cw;
+      coef->b2 = coef->b0;
+      break;
+  }
+
+  coef->b0 /= a0;
+  coef->b1 /= a0;
+  coef->b2 /= a0;
+  coef->a1 = (-2.0f * cw) / a0;
+  coef->a2 = (1.0f - al) / a0;
+}
+
+/**
+  * @brief  Initialize a biquad cascade; all the sections are set to
+  *         pass-through and the state is cleared.
+  *
+  * @param  st       cascade state
+  * @param  coef     coefficient storage, 5 * sections * lanes elements
+  * @param  z        delay line storage, 2 * sections * lanes elements
+  * @param  sections number of sections
+  * @param  lanes    number of lanes
+  *
+  */
+void ais2dw12_biquad_init(ais2dw12_biquad_t *st, float_t *coef, float_t *z,
+                          uint8_t sections, uint16_t lanes)
+{
+  ais2dw12_biquad_coef_t pass = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+  uint32_t i;
+  uint16_t l;
+  uint8_t s;
+
+  st->coef = coef;
+  st->z = z;
+  st->sections = sections;
+  st->lanes = lanes;
+
+  for (s = 0U; s < sections; s++)
+  {
+    for (l = 0U; l < lanes; l++)
+    {
+      ais2dw12_biquad_set(st, s, l, &pass);
+    }
+  }
+
+  for (i = 0U; i < (2U * (uint32_t)sections * lanes); i++)
+  {
+    z[i] = 0.0f;
+  }
+}
+
+/**
+  * @brief  Set the coefficients of a section for one lane, so each
+  *         device can use its own filter design.[set]
+  *
+  * @param  st       cascade state
+  * @param  section  section index
+  * @param  lane     lane index
+  * @param  coef     section coefficients
+  *
+  */
+void ais2dw12_biquad_set(ais2dw12_biquad_t *st, uint8_t section,
+                         uint16_t lane, const ais2dw12_biquad_coef_t *coef)
+{
+  float_t *c;
+
+  c = &st->coef[5U * (uint32_t)section * st->lanes];
+  c[lane] = coef->b0;
+  c[st->lanes + lane] = coef->b1;
+  c[(2U * st->lanes) + lane] = coef->b2;
+  c[(3U * st->lanes) + lane] = coef->a1;
+  c[(4U * st->lanes) + lane] = coef->a2;
+}
+
+/**
+  * @brief  Filter len frames of st->lanes samples. In-place operation
+  *         (in == out) is allowed.
+  *
+  * @param  st       cascade state
+  * @param  in       input frames ([sample][lane])
+  * @param  out      output frames ([sample][lane])
+  * @param  len      number of frames
+  *
+  */
+void ais2dw12_biquad_run(ais2dw12_biquad_t *st, const float_t *in,
+                         float_t *out, uint16_t len)
+{
+  const float_t *c;
+  const float_t *x;
+  float_t *s1;
+  float_t *s2;
+  float_t *y;
+  float_t v;
+  float_t r;
+  uint16_t n;
+  uint16_t l;
+  uint16_t nl;
+  uint8_t s;
+
+  nl = st->lanes;
+
+  for (n = 0U; n < len; n++)
+  {
+    x = &in[(uint32_t)n * nl];
+    y = &out[(uint32_t)n * nl];
+
+    for (s = 0U; s < st->sections; s++)
+    {
+      c = &st->coef[5U * (uint32_t)s * nl];
+      s1 = &st->z[2U * (uint32_t)s * nl];
+      s2 = &s1[nl];
+
+      for (l = 0U; l < nl; l++)
+      {
+        v = x[l];
+        r = (c[l] * v) + s1[l];
+        s1[l] = (c[nl + l] * v) - (c[(3U * nl) + l] * r) + s2[l];
+        s2[l] = (c[(2U * nl) + l] * v) - (c[(4U * nl) + l] * r);
+        y[l] = r;
+      }
+
+      x = y;
+    }
+
+    if (st->sections == 0U)
+    {
+      for (l = 0U; l < nl; l++)
+      {
+        y[l] = x[l];
+      }
+    }
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Noise_Characterization
+  * @brief     This section groups the functions that compute the Allan
+  *            deviation of static captures at octave spaced averaging
+  *            times, with memory independent of the capture length and
+  *            O(1) amortized work per sample.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize an Allan deviation estimator.
+  *
+  * @param  st       estimator state
+  * @param  odr_hz   sample rate in Hz
+  *
+  */
+void ais2dw12_allan_init(ais2dw12_allan_t *st, float_t odr_hz)
+{
+  uint8_t a;
+  uint8_t k;
+
+  st->odr_hz = odr_hz;
+  st->num = 0U;
+
+  for (a = 0U; a < 3U; a++)
+  {
+    for (k = 0U; k < AIS2DW12_ALLAN_LEVELS; k++)
+    {
+      st->lvl[a][k].prev = 0.0f;
+      st->lvl[a][k].c[0] = 0.0f;
+      st->lvl[a][k].c[1] = 0.0f;
+      st->lvl[a][k].sum = 0.0f;
+      st->lvl[a][k].comp = 0.0f;
+      st->lvl[a][k].cnt = 0U;
+      st->lvl[a][k].in = 0U;
+    }
+  }
+}
+
+/**
+  * @brief  Feed samples (mg) to the Allan deviation estimator.
+  *         Level k receives the non-overlapped clusters of level k-1
+  *         and forms a cluster of 2^k samples at every input, so
+  *         adjacent clusters are compared with 50% overlap.
+  *
+  * @param  st       estimator state
+  * @param  x        X-axis samples
+  * @param  y        Y-axis samples
+  * @param  z        Z-axis samples
+  * @param  len      number of samples
+  *
+  */
+void ais2dw12_allan_update(ais2dw12_allan_t *st, const float_t *x,
+                           const float_t *y, const float_t *z, uint16_t len)
+{
+  ais2dw12_allan_lvl_t *l;
+  const float_t *in[3];
+  float_t b;
+  float_t c;
+  uint16_t i;
+  uint8_t a;
+  uint8_t k;
+  uint8_t more;
+
+  in[0] = x;
+  in[1] = y;
+  in[2] = z;
+
+  for (i = 0U; i < len; i++)
+  {
+    for (a = 0U; a < 3U; a++)
+    {
+      b = in[a][i];
+
+      /* level 0: clusters of one sample, all of them feed level 1 */
+      l = &st->lvl[a][0];
+      l->in++;
+
+      if (l->in > 1U)
+      {
+        allan_acc(l, b - l->prev);
+      }
+
+      l->prev = b;
+      more = PROPERTY_ENABLE;
+
+      for (k = 1U; (k < AIS2DW12_ALLAN_LEVELS) && (more == PROPERTY_ENABLE);
+           k++)
+      {
+        l = &st->lvl[a][k];
+        l->in++;
+        more = PROPERTY_DISABLE;
+
+        if (l->in > 1U)
+        {
+          c = 0.5f * (l->prev + b);
+
+          /* c[0] is the adjacent cluster ending where c starts */
+          if (l->in > 3U)
+          {
+            allan_acc(l, c - l->c[0]);
+          }
+
+          l->c[0] = l->c[1];
+          l->c[1] = c;
+          l->prev = b;
+
+          if ((l->in % 2U) == 0U)
+          {
+            b = c;
+            more = PROPERTY_ENABLE;
+          }
+        }
+
+        else
+        {
+          l->prev = b;
+        }
+      }
+    }
+
+    st->num++;
+  }
+}
+
+/**
+  * @brief  Get the Allan deviation curve of the samples fed so far.
+  *
+  * @param  st       estimator state
+  * @param  out      averaging times and deviations (mg) per axis
+  * @retval          number of levels with at least one cluster pair
+  *
+  */
+uint8_t ais2dw12_allan_get(const ais2dw12_allan_t *st,
+                           ais2dw12_allan_out_t *out)
+{
+  float_t adev;
+  uint8_t num;
+  uint8_t a;
+  uint8_t k;
+
+  num = 0U;
+  out->noise_density[0] = 0.0f;
+  out->noise_density[1] = 0.0f;
+  out->noise_density[2] = 0.0f;
+  out->bias_instab[0] = 0.0f;
+  out->bias_instab[1] = 0.0f;
+  out->bias_instab[2] = 0.0f;
+
+  for (k = 0U; (k < AIS2DW12_ALLAN_LEVELS) && (st->lvl[0][k].cnt > 0U); k++)
+  {
+    out->tau[k] = (float_t)((uint32_t)1U << k) / st->odr_hz;
+
+    for (a = 0U; a < 3U; a++)
+    {
+      adev = sqrtf(st->lvl[a][k].sum /
+                   (2.0f * (float_t)st->lvl[a][k].cnt));
+      out->adev[a][k] = adev;
+
+      /* bias instability: flat floor of the curve scaled by 0.664,
+       * levels with few cluster pairs are too noisy to be trusted */
+      if ((k == 0U) || (((adev / 0.664f) < out->bias_instab[a]) &&
+                        (st->lvl[a][k].cnt >= AIS2DW12_ALLAN_MIN_CNT)))
+      {
+        out->bias_instab[a] = adev / 0.664f;
+      }
+    }
+
+    num++;
+  }
+
+  if (num > 0U)
+  {
+    /* white noise: sigma(tau) * sqrt(tau), at the shortest tau */
+    for (a = 0U; a < 3U; a++)
+    {
+      out->noise_density[a] = out->adev[a][0] * sqrtf(out->tau[0]);
+    }
+  }
+
+  out->num = num;
+
+  return num;
+}
+
+/**
+  * @brief  Configure power mode and bandwidth, drop the samples produced
+  *         while the output settles, then feed num samples polled on
+  *         data-ready to the estimator. STATUS and the output registers
+  *         are read with a single transaction per poll
+  *         (ais2dw12_single_shot_data_get). Device must be already
+  *         running at the data rate given to ais2dw12_allan_init.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  st       estimator state
+  * @param  mode     power mode under characterization
+  * @param  bw       filter bandwidth under characterization
+  * @param  num      number of samples to capture
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_allan_capture(const stmdev_ctx_t *ctx, ais2dw12_allan_t *st,
+                               ais2dw12_mode_t mode, ais2dw12_bw_filt_t bw,
+                               uint32_t num)
+{
+  const uint8_t settle[4] = AIS2DW12_SETTLE_SAMPLES;
+  ais2dw12_poll_t poll;
+  ais2dw12_fs_t fs;
+  int16_t raw[3];
+  float_t sens;
+  float_t s[3];
+  uint32_t drop;
+  uint32_t i;
+  int32_t ret;
+
+  /* wait up to two sample periods for each data-ready */
+  poll.wait_ms = 0U;
+  poll.poll_ms = 1U;
+  poll.retries = (st->odr_hz > 0.1f) ?
+                 (uint16_t)(2000.0f / st->odr_hz) + 2U : 0xFFFFU;
+  sens = 0.061f;
+  drop = settle[(uint8_t)bw & 0x03U];
+  i = 0U;
+
+  ret = ais2dw12_power_mode_set(ctx, mode);
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_filter_bandwidth_set(ctx, bw);
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_full_scale_get(ctx, &fs);
+    sens = fs_sens((uint8_t)fs);
+  }
+
+  while ((ret == 0) && (i < (num + drop)))
+  {
+    ret = ais2dw12_single_shot_data_get(ctx, &poll, raw);
+
+    if ((ret == 0) && (i >= drop))
+    {
+      s[0] = (float_t)raw[0] * sens;
+      s[1] = (float_t)raw[1] * sens;
+      s[2] = (float_t)raw[2] * sens;
+      ais2dw12_allan_update(st, &s[0], &s[1], &s[2], 1U);
+    }
+
+    i++;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Calibration
+  * @brief     This section groups the functions that compute bias and
+  *            scale factor of each axis from averaged samples collected
+  *            with the device at rest in six orientations, and store
+  *            the bias in the user offset registers.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a six-position calibration.
+  *
+  * @param  cal      calibration state
+  *
+  */
+void ais2dw12_calib_init(ais2dw12_calib_t *cal)
+{
+  uint8_t p;
+
+  for (p = 0U; p < 6U; p++)
+  {
+    cal->sum[p][0] = 0.0f;
+    cal->sum[p][1] = 0.0f;
+    cal->sum[p][2] = 0.0f;
+    cal->cnt[p] = 0U;
+  }
+}
+
+/**
+  * @brief  Accumulate samples (mg) collected at rest in one orientation.
+  *         User offset correction must be disabled while collecting.
+  *
+  * @param  cal      calibration state
+  * @param  pos      orientation of the device
+  * @param  x        X-axis samples
+  * @param  y        Y-axis samples
+  * @param  z        Z-axis samples
+  * @param  len      number of samples
+  *
+  */
+void ais2dw12_calib_add(ais2dw12_calib_t *cal, ais2dw12_calib_pos_t pos,
+                        const float_t *x, const float_t *y,
+                        const float_t *z, uint16_t len)
+{
+  float_t *sum;
+  uint16_t i;
+
+  sum = cal->sum[(uint8_t)pos];
+
+  for (i = 0U; i < len; i++)
+  {
+    sum[0] += x[i];
+    sum[1] += y[i];
+    sum[2] += z[i];
+  }
+
+  cal->cnt[(uint8_t)pos] += len;
+}
+
+/**
+  * @brief  Solve bias and scale factor of each axis. For each axis the
+  *         up and down orientations give bias = (up + down) / 2 and
+  *         scale = (up - down) / 2000 mg.
+  *
+  * @param  cal      calibration state
+  * @param  bias     bias of each axis (mg)
+  * @param  scale    scale factor of each axis (1.0 -> ideal)
+  * @retval          0 -> solved, -1 -> orientations missing
+  *
+  */
+int32_t ais2dw12_calib_solve(const ais2dw12_calib_t *cal, float_t *bias,
+                             float_t *scale)
+{
+  float_t up;
+  float_t down;
+  uint8_t a;
+  int32_t ret;
+
+  ret = 0;
+
+  for (a = 0U; (a < 3U) && (ret == 0); a++)
+  {
+    if ((cal->cnt[2U * a] == 0U) || (cal->cnt[(2U * a) + 1U] == 0U))
+    {
+      ret = -1;
+    }
+
+    else
+    {
+      up = cal->sum[2U * a][a] / (float_t)cal->cnt[2U * a];
+      down = cal->sum[(2U * a) + 1U][a] / (float_t)cal->cnt[(2U * a) + 1U];
+      bias[a] = 0.5f * (up + down);
+      scale[a] = (up - down) / 2000.0f;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Quantize the bias into user offset register units. The
+  *         finest weight that can represent all the axes is selected.
+  *
+  * @param  bias     bias of each axis (mg)
+  * @param  weight   selected weight of the offset registers
+  * @param  ofs      X_OFS_USR, Y_OFS_USR, Z_OFS_USR values
+  * @retval          0 -> in range, -1 -> bias saturated at 15.6 mg weight
+  *
+  */
+int32_t ais2dw12_calib_offset_get(const float_t *bias,
+                                  ais2dw12_usr_off_w_t *weight,
+                                  int8_t *ofs)
+{
+  float_t lsb;
+  float_t max;
+  float_t q;
+  uint8_t a;
+  int32_t ret;
+
+  max = 0.0f;
+  ret = 0;
+
+  for (a = 0U; a < 3U; a++)
+  {
+    q = fabsf(bias[a]);
+    max = (q > max) ? q : max;
+  }
+
+  if (max <= (127.0f * AIS2DW12_OFS_977UG_MG))
+  {
+    *weight = AIS2DW12_LSb_977ug;
+    lsb = AIS2DW12_OFS_977UG_MG;
+  }
+
+  else
+  {
+    *weight = AIS2DW12_LSb_15mg6;
+    lsb = AIS2DW12_OFS_15MG6_MG;
+  }
+
+  for (a = 0U; a < 3U; a++)
+  {
+    /* offset is subtracted from the output: same sign as the bias */
+    if (ofs_quantize(bias[a], lsb, &ofs[a]) != 0)
+    {
+      ret = -1;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Store the bias in the user offset registers (single burst),
+  *         set their weight and apply them on the output data.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  bias     bias of each axis (mg)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *                  -1 also if the bias saturates the offset registers
+  *
+  */
+int32_t ais2dw12_calib_offset_set(const stmdev_ctx_t *ctx,
+                                  const float_t *bias)
+{
+  ais2dw12_usr_off_w_t weight;
+  int8_t ofs[3];
+  uint8_t buff[3];
+  int32_t ret;
+
+  ret = ais2dw12_calib_offset_get(bias, &weight, ofs);
+
+  if (ret == 0)
+  {
+    buff[0] = (uint8_t)ofs[0];
+    buff[1] = (uint8_t)ofs[1];
+    buff[2] = (uint8_t)ofs[2];
+    ret = ais2dw12_usr_offset_set(ctx, buff);
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_offset_weight_set(ctx, weight);
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_filter_path_set(ctx, AIS2DW12_USER_OFFSET_ON_OUT);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Bias_Tracking
+  * @brief     This section groups the functions that refine the bias
+  *            stored in the user offset registers while the device is
+  *            at rest in its mounting orientation. Registers are
+  *            written only when the quantized offset changes.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the bias tracker from the user offset registers
+  *         and their weight currently set in the device. Output data
+  *         fed to the tracker must include the user offset correction
+  *         (AIS2DW12_USER_OFFSET_ON_OUT). If the registers can't be
+  *         read the tracker starts from a null offset.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  st       tracker state
+  * @param  ref      gravity vector at rest in the mounting orientation (mg)
+  * @param  alpha    EWMA weight of each stationary window, (0 1]
+  * @param  var_ths  maximum per-axis variance of a stationary window (mg^2)
+  * @param  win      samples per window, at least 1
+  * @param  src      stationary detection source
+  * @retval          interface status (MANDATORY: return 0 -> no Error),
+  *                  -1 also if win is 0
+  *
+  */
+int32_t ais2dw12_bias_track_init(const stmdev_ctx_t *ctx,
+                                 ais2dw12_bias_track_t *st,
+                                 const float_t *ref, float_t alpha,
+                                 float_t var_ths, uint16_t win,
+                                 ais2dw12_still_src_t src)
+{
+  uint8_t buff[3];
+  uint8_t a;
+  int32_t ret;
+
+  if (win == 0U)
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    ret = ais2dw12_usr_offset_get(ctx, buff);
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_offset_weight_get(ctx, &st->weight);
+  }
+
+  if (ret != 0)
+  {
+    buff[0] = 0U;
+    buff[1] = 0U;
+    buff[2] = 0U;
+    st->weight = AIS2DW12_LSb_977ug;
+  }
+
+  st->lsb = (st->weight == AIS2DW12_LSb_15mg6) ?
+            AIS2DW12_OFS_15MG6_MG : AIS2DW12_OFS_977UG_MG;
+
+  for (a = 0U; a < 3U; a++)
+  {
+    st->ofs[a] = (int8_t)buff[a];
+    st->bias[a] = (float_t)st->ofs[a] * st->lsb;
+    st->ref[a] = ref[a];
+    st->sum[a] = 0.0f;
+    st->sq[a] = 0.0f;
+    st->shift[a] = 0.0f;
+  }
+
+  st->alpha = alpha;
+  st->var_ths = var_ths;
+  st->win = win;
+  st->n = 0U;
+  st->src = src;
+  st->upd = 0U;
+  st->still = PROPERTY_DISABLE;
+  st->skip = 0U;
+
+  return ret;
+}
+
+/**
+  * @brief  Feed samples (mg) to the bias tracker. At the end of each
+  *         stationary window the residual against the reference
+  *         gravity refines the bias, and the offset registers are
+  *         updated with a single burst if their value changes.
+  *         A window is stationary when the variance of each axis is
+  *         below var_ths and, with AIS2DW12_STILL_SLEEP_STATE, the
+  *         device reports sleep state both at its first and at its
+  *         last sample. The window following an offset update is
+  *         discarded: samples already queued (e.g. in FIFO) were
+  *         produced with the previous offset.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  st       tracker state
+  * @param  x        X-axis samples
+  * @param  y        Y-axis samples
+  * @param  z        Z-axis samples
+  * @param  len      number of samples
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_bias_track_run(const stmdev_ctx_t *ctx,
+                                ais2dw12_bias_track_t *st,
+                                const float_t *x, const float_t *y,
+                                const float_t *z, uint16_t len)
+{
+  ais2dw12_status_t status;
+  const float_t *in[3];
+  float_t res[3];
+  float_t mean;
+  float_t d;
+  int8_t ofs[3];
+  uint8_t buff[3];
+  uint8_t still;
+  uint8_t a;
+  uint16_t i;
+  int32_t ret;
+
+  ret = 0;
+  in[0] = x;
+  in[1] = y;
+  in[2] = z;
+
+  for (i = 0U; (i < len) && (ret == 0); i++)
+  {
+    if ((st->n == 0U) && (st->src == AIS2DW12_STILL_SLEEP_STATE))
+    {
+      ret = ais2dw12_status_reg_get(ctx, &status);
+      st->still = status.sleep_state;
+    }
+
+    for (a = 0U; a < 3U; a++)
+    {
+      /* shifted by the first sample to keep the variance accurate */
+      if (st->n == 0U)
+      {
+        st->shift[a] = in[a][i];
+      }
+
+      d = in[a][i] - st->shift[a];
+      st->sum[a] += d;
+      st->sq[a] += d * d;
+    }
+
+    st->n++;
+
+    if (st->n == st->win)
+    {
+      still = (st->skip == 0U) ? PROPERTY_ENABLE : PROPERTY_DISABLE;
+      st->skip = 0U;
+
+      if ((ret == 0) && (st->src == AIS2DW12_STILL_SLEEP_STATE))
+      {
+        ret = ais2dw12_status_reg_get(ctx, &status);
+
+        if ((st->still == PROPERTY_DISABLE) ||
+            (status.sleep_state == PROPERTY_DISABLE))
+        {
+          still = PROPERTY_DISABLE;
+        }
+      }
+
+      for (a = 0U; (a < 3U) && (ret == 0); a++)
+      {
+        mean = st->sum[a] / (float_t)st->n;
+
+        if (((st->sq[a] / (float_t)st->n) - (mean * mean)) > st->var_ths)
+        {
+          still = PROPERTY_DISABLE;
+        }
+
+        /* residual bias left by the offset currently applied */
+        res[a] = mean + st->shift[a] - st->ref[a];
+      }
+
+      if ((ret == 0) && (still != PROPERTY_DISABLE))
+      {
+        for (a = 0U; a < 3U; a++)
+        {
+          d = ((float_t)st->ofs[a] * st->lsb) + res[a];
+          st->bias[a] += st->alpha * (d - st->bias[a]);
+          (void)ofs_quantize(st->bias[a], st->lsb, &ofs[a]);
+        }
+
+        if ((ofs[0] != st->ofs[0]) || (ofs[1] != st->ofs[1]) ||
+            (ofs[2] != st->ofs[2]))
+        {
+          buff[0] = (uint8_t)ofs[0];
+          buff[1] = (uint8_t)ofs[1];
+          buff[2] = (uint8_t)ofs[2];
+          ret = ais2dw12_usr_offset_set(ctx, buff);
+
+          if (ret == 0)
+          {
+            st->ofs[0] = ofs[0];
+            st->ofs[1] = ofs[1];
+            st->ofs[2] = ofs[2];
+            st->upd++;
+            st->skip = 1U;
+          }
+        }
+      }
+
+      for (a = 0U; a < 3U; a++)
+      {
+        st->sum[a] = 0.0f;
+        st->sq[a] = 0.0f;
+      }
+
+      st->n = 0U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Temperature_Compensation
+  * @brief     This section groups the functions that model bias and
+  *            scale factor of each axis against temperature and apply
+  *            them in the block conversion through a lookup table
+  *            indexed by the 8-bit OUT_T value.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Build the compensation table from bias and scale factor
+  *         measured at several temperatures (e.g. with
+  *         ais2dw12_calib_solve). Least squares polynomial models
+  *         need at least deg + 1 points, the piecewise-linear model
+  *         needs points sorted by temperature. All the models hold the
+  *         values at the ends of the calibrated temperature range
+  *         outside of it.
+  *
+  * @param  lut      compensation table
+  * @param  pt       calibration points
+  * @param  num      number of calibration points
+  * @param  model    temperature model
+  * @retval          0 -> built, -1 -> not enough or inconsistent points
+  *
+  */
+int32_t ais2dw12_tcomp_lut_build(ais2dw12_tcomp_lut_t *lut,
+                                 const ais2dw12_tcomp_pt_t *pt,
+                                 uint16_t num, ais2dw12_tcomp_model_t model)
+{
+  float_t c[4][6];
+  float_t v[6];
+  float_t t_min;
+  float_t t_max;
+  float_t t;
+  float_t u;
+  float_t f;
+  uint16_t i;
+  uint16_t s;
+  uint8_t deg;
+  uint8_t a;
+  uint8_t k;
+  int32_t ret;
+
+  ret = 0;
+  t_min = (num > 0U) ? pt[0].temp_c : 0.0f;
+  t_max = t_min;
+
+  for (i = 1U; i < num; i++)
+  {
+    t_min = (pt[i].temp_c < t_min) ? pt[i].temp_c : t_min;
+    t_max = (pt[i].temp_c > t_max) ? pt[i].temp_c : t_max;
+  }
+
+  if (model == AIS2DW12_TCOMP_PWL)
+  {
+    for (i = 1U; i < num; i++)
+    {
+      if (pt[i].temp_c <= pt[i - 1U].temp_c)
+      {
+        ret = -1;
+      }
+    }
+
+    ret = (num == 0U) ? -1 : ret;
+  }
+
+  else
+  {
+    deg = (uint8_t)model;
+    ret = (num <= deg) ? -1 : tcomp_poly_fit(pt, num, deg, c);
+  }
+
+  /* OUT_T two's complement, 1 LSB = 1 degC, 0 = 25 degC */
+  for (i = 0U; (i < 256U) && (ret == 0); i++)
+  {
+    t = (float_t)(int8_t)(uint8_t)i + 25.0f;
+
+    if (model == AIS2DW12_TCOMP_PWL)
+    {
+      s = 0U;
+
+      while (((s + 1U) < num) && (pt[s + 1U].temp_c <= t))
+      {
+        s++;
+      }
+
+      f = 0.0f;
+
+      if (((s + 1U) < num) && (t > pt[s].temp_c))
+      {
+        f = (t - pt[s].temp_c) / (pt[s + 1U].temp_c - pt[s].temp_c);
+      }
+
+      for (a = 0U; a < 3U; a++)
+      {
+        v[a] = pt[s].bias[a];
+        v[3U + a] = pt[s].scale[a];
+
+        if (f > 0.0f)
+        {
+          v[a] += f * (pt[s + 1U].bias[a] - pt[s].bias[a]);
+          v[3U + a] += f * (pt[s + 1U].scale[a] - pt[s].scale[a]);
+        }
+      }
+    }
+
+    else
+    {
+      /* no extrapolation of the fit outside of the calibrated range */
+      t = (t < t_min) ? t_min : t;
+      t = (t > t_max) ? t_max : t;
+      u = (t - 25.0f) / 50.0f;
+
+      for (k = 0U; k < 6U; k++)
+      {
+        v[k] = c[3][k];
+        v[k] = (v[k] * u) + c[2][k];
+        v[k] = (v[k] * u) + c[1][k];
+        v[k] = (v[k] * u) + c[0][k];
+      }
+    }
+
+    for (a = 0U; (a < 3U) && (ret == 0); a++)
+    {
+      if (v[3U + a] <= 0.0f)
+      {
+        ret = -1;
+      }
+
+      else
+      {
+        lut->bias[a][i] = v[a];
+        lut->gain[a][i] = 1.0f / v[3U + a];
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Convert a block to compensated mg:
+  *         out = (raw * sensitivity - bias(T)) / scale(T).
+  *         The table is read once per block, so the per-sample cost is
+  *         the same as ais2dw12_blk_to_mg.
+  *
+  * @param  blk      input block
+  * @param  lut      compensation table
+  * @param  temp     last known OUT_T value, updated from the block if
+  *                  it carries a temperature sample
+  * @param  x        X-axis output, blk->len samples
+  * @param  y        Y-axis output, blk->len samples
+  * @param  z        Z-axis output, blk->len samples
+  *
+  */
+void ais2dw12_blk_to_mg_comp(const ais2dw12_blk_t *blk,
+                             const ais2dw12_tcomp_lut_t *lut, int8_t *temp,
+                             float_t *x, float_t *y, float_t *z)
+{
+  float_t sens;
+  float_t k[3];
+  float_t c[3];
+  uint16_t i;
+  uint8_t t;
+  uint8_t a;
+
+  if ((blk->flags & AIS2DW12_BLK_TEMP) != 0U)
+  {
+    *temp = blk->temp;
+  }
+
+  sens = fs_sens(blk->fs);
+  t = (uint8_t)*temp;
+
+  for (a = 0U; a < 3U; a++)
+  {
+    k[a] = sens * lut->gain[a][t];
+    c[a] = -lut->bias[a][t] * lut->gain[a][t];
+  }
+
+  for (i = 0U; i < blk->len; i++)
+  {
+    x[i] = ((float_t)blk->x[i] * k[0]) + c[0];
+    y[i] = ((float_t)blk->y[i] * k[1]) + c[1];
+    z[i] = ((float_t)blk->z[i] * k[2]) + c[2];
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Load_Spectrum
+  * @brief     This section groups the functions that reduce a stream of
+  *            samples to cumulative load spectra: rainflow counted
+  *            ranges and amplitude / duration shock histograms. State
+  *            is bounded, histograms are flushed on demand as 16-bit
+  *            counters.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a rainflow counter.
+  *
+  * @param  st       rainflow counter state
+  * @param  hist     range histogram, bins counters (half cycles)
+  * @param  bins     number of range bins, the last one collects the
+  *                  larger ranges
+  * @param  bin_mg   width of a range bin (mg)
+  * @param  hyst     reversals smaller than hyst are ignored (mg)
+  * @retval          0 -> initialized, -1 -> no bins or null bin width
+  *
+  */
+int32_t ais2dw12_rfc_init(ais2dw12_rfc_t *st, uint32_t *hist, uint16_t bins,
+                          float_t bin_mg, float_t hyst)
+{
+  uint16_t i;
+  int32_t ret;
+
+  ret = ((bins == 0U) || (bin_mg <= 0.0f)) ? -1 : 0;
+
+  if (ret == 0)
+  {
+    for (i = 0U; i < bins; i++)
+    {
+      hist[i] = 0U;
+    }
+
+    st->hist = hist;
+    st->bins = bins;
+    st->bin_mg = bin_mg;
+    st->hyst = hyst;
+    st->ext = 0.0f;
+    st->depth = 0U;
+    st->dir = 0;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Feed samples (mg) to the rainflow counter. Closed cycles
+  *         are counted as two half cycles in the bin of their range,
+  *         open reversals stay in the residue.
+  *
+  * @param  st       rainflow counter state
+  * @param  x        samples
+  * @param  len      number of samples
+  *
+  */
+void ais2dw12_rfc_run(ais2dw12_rfc_t *st, const float_t *x, uint16_t len)
+{
+  float_t v;
+  uint16_t i;
+
+  for (i = 0U; i < len; i++)
+  {
+    v = x[i];
+
+    if (st->depth == 0U)
+    {
+      /* first sample opens the residue */
+      rfc_push(st, v);
+      st->ext = v;
+    }
+
+    else if (st->dir == 0)
+    {
+      if (fabsf(v - st->ext) > st->hyst)
+      {
+        st->dir = (v > st->ext) ? 1 : -1;
+        st->ext = v;
+      }
+    }
+
+    else if (((st->dir > 0) && (v > st->ext)) ||
+             ((st->dir < 0) && (v < st->ext)))
+    {
+      st->ext = v;
+    }
+
+    else if (fabsf(st->ext - v) > st->hyst)
+    {
+      /* the running extreme is confirmed as a reversal */
+      rfc_push(st, st->ext);
+      st->dir = -st->dir;
+      st->ext = v;
+    }
+
+    else
+    {
+      /* within hysteresis */
+    }
+  }
+}
+
+/**
+  * @brief  Copy the range histogram, saturated to 16 bits, and clear it.
+  *
+  * @param  st       rainflow counter state
+  * @param  out      histogram output, bins counters (half cycles)
+  * @retval          number of bins
+  *
+  */
+uint16_t ais2dw12_rfc_flush(ais2dw12_rfc_t *st, uint16_t *out)
+{
+  hist_flush(st->hist, out, st->bins);
+
+  return st->bins;
+}
+
+/**
+  * @brief  Initialize a shock histogram. An event starts when the
+  *         absolute value exceeds ths and ends when it falls below
+  *         ths - hyst; it is counted in the bin of its peak amplitude
+  *         above ths and of its duration, binned by octaves of
+  *         samples (1, 2-3, 4-7, ...).
+  *
+  * @param  st       shock histogram state
+  * @param  hist     histogram, amp_bins x dur_bins counters
+  * @param  amp_bins number of amplitude bins
+  * @param  dur_bins number of duration bins
+  * @param  ths      event threshold (mg)
+  * @param  amp_step width of an amplitude bin (mg)
+  * @param  hyst     release hysteresis (mg)
+  * @retval          0 -> initialized, -1 -> no bins or null bin width
+  *
+  */
+int32_t ais2dw12_shock_init(ais2dw12_shock_t *st, uint32_t *hist,
+                            uint8_t amp_bins, uint8_t dur_bins, float_t ths,
+                            float_t amp_step, float_t hyst)
+{
+  uint16_t i;
+  int32_t ret;
+
+  ret = ((amp_bins == 0U) || (dur_bins == 0U) || (amp_step <= 0.0f)) ?
+        -1 : 0;
+
+  if (ret == 0)
+  {
+    for (i = 0U; i < ((uint16_t)amp_bins * dur_bins); i++)
+    {
+      hist[i] = 0U;
+    }
+
+    st->hist = hist;
+    st->amp_bins = amp_bins;
+    st->dur_bins = dur_bins;
+    st->ths = ths;
+    st->amp_step = amp_step;
+    st->hyst = hyst;
+    st->peak = 0.0f;
+    st->dur = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Feed samples (mg) to the shock histogram.
+  *
+  * @param  st       shock histogram state
+  * @param  x        samples
+  * @param  len      number of samples
+  * @retval          number of events closed
+  *
+  */
+uint16_t ais2dw12_shock_run(ais2dw12_shock_t *st, const float_t *x,
+                            uint16_t len)
+{
+  float_t v;
+  uint32_t d;
+  uint16_t i;
+  uint16_t num;
+  uint8_t amp;
+  uint8_t dur;
+
+  num = 0U;
+
+  for (i = 0U; i < len; i++)
+  {
+    v = fabsf(x[i]);
+
+    if ((st->dur > 0U) && (v >= (st->ths - st->hyst)))
+    {
+      st->peak = (v > st->peak) ? v : st->peak;
+      st->dur += (st->dur < 0xFFFFFFFFU) ? 1U : 0U;
+    }
+
+    else if (st->dur > 0U)
+    {
+      v = (st->peak - st->ths) / st->amp_step;
+      amp = (v >= (float_t)st->amp_bins) ?
+            (st->amp_bins - 1U) : (uint8_t)v;
+
+      d = st->dur;
+      dur = 0U;
+
+      while (d > 1U)
+      {
+        d >>= 1;
+        dur++;
+      }
+
+      dur = (dur >= st->dur_bins) ? (st->dur_bins - 1U) : dur;
+      st->hist[((uint16_t)amp * st->dur_bins) + dur]++;
+      st->dur = 0U;
+      num++;
+    }
+
+    else if (v > st->ths)
+    {
+      st->peak = v;
+      st->dur = 1U;
+    }
+
+    else
+    {
+      /* no event */
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @brief  Copy the shock histogram, saturated to 16 bits, and clear it.
+  *
+  * @param  st       shock histogram state
+  * @param  out      histogram output, amp_bins x dur_bins counters
+  * @retval          number of counters
+  *
+  */
+uint16_t ais2dw12_shock_flush(ais2dw12_shock_t *st, uint16_t *out)
+{
+  uint16_t num;
+
+  num = (uint16_t)st->amp_bins * st->dur_bins;
+  hist_flush(st->hist, out, num);
+
+  return num;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Velocity
+  * @brief     This section groups the functions that integrate
+  *            acceleration frames into band-limited velocity and
+  *            report its RMS value per window, as required by the
+  *            vibration severity standards. Lanes are interleaved as
+  *            in AIS2DW12_Biquad, so the same stage covers all the
+  *            axes of many devices.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a velocity integrator: band limit with a
+  *         high-pass at f_lo and a low-pass at f_hi (Butterworth
+  *         biquads), then leaky trapezoidal integration with the leak
+  *         corner at f_lo / 4 to bound the drift.
+  *
+  * @param  st       integrator state
+  * @param  buf      storage, AIS2DW12_VELO_BUF_LEN(lanes) elements
+  * @param  lanes    number of lanes
+  * @param  odr_hz   sample rate in Hz
+  * @param  f_lo     lower band edge in Hz
+  * @param  f_hi     upper band edge in Hz
+  * @param  win      samples per RMS window
+  *
+  */
+void ais2dw12_velo_init(ais2dw12_velo_t *st, float_t *buf, uint16_t lanes,
+                        float_t odr_hz, float_t f_lo, float_t f_hi,
+                        uint16_t win)
+{
+  ais2dw12_biquad_coef_t coef;
+  uint32_t i;
+  uint16_t l;
+
+  ais2dw12_biquad_init(&st->band, buf, &buf[10U * (uint32_t)lanes], 2U,
+                       lanes);
+  ais2dw12_biquad_design(&coef, AIS2DW12_BIQUAD_HIGH_PASS, f_lo, 0.7071f,
+                         odr_hz);
+
+  for (l = 0U; l < lanes; l++)
+  {
+    ais2dw12_biquad_set(&st->band, 0U, l, &coef);
+  }
+
+  ais2dw12_biquad_design(&coef, AIS2DW12_BIQUAD_LOW_PASS, f_hi, 0.7071f,
+                         odr_hz);
+
+  for (l = 0U; l < lanes; l++)
+  {
+    ais2dw12_biquad_set(&st->band, 1U, l, &coef);
+  }
+
+  st->v = &buf[14U * (uint32_t)lanes];
+  st->prev = &st->v[lanes];
+  st->sq = &st->prev[lanes];
+
+  for (i = 0U; i < (3U * (uint32_t)lanes); i++)
+  {
+    st->v[i] = 0.0f;
+  }
+
+  /* mg to mm/s^2, times dt / 2 for the trapezoidal rule */
+  st->k = (9.80665f * 0.5f) / odr_hz;
+  st->leak = expf((-AIS2DW12_2PI * 0.25f * f_lo) / odr_hz);
+  st->lanes = lanes;
+  st->win = win;
+  st->n = 0U;
+}
+
+/**
+  * @brief  Integrate len frames in place: acceleration (mg) in,
+  *         velocity (mm/s) out. At the end of each window the RMS
+  *         velocity of every lane is written to rms.
+  *
+  * @param  st       integrator state
+  * @param  buf      frames ([sample][lane]), overwritten
+  * @param  len      number of frames
+  * @param  rms      RMS output (mm/s), max_win * lanes elements
+  * @param  max_win  maximum number of windows to report
+  * @retval          number of windows reported
+  *
+  */
+uint16_t ais2dw12_velo_run(ais2dw12_velo_t *st, float_t *buf, uint16_t len,
+                           float_t *rms, uint16_t max_win)
+{
+  float_t *a;
+  float_t *v;
+  float_t *p;
+  float_t *sq;
+  float_t *r;
+  float_t leak;
+  float_t k;
+  uint16_t nl;
+  uint16_t num;
+  uint16_t n;
+  uint16_t l;
+
+  v = st->v;
+  p = st->prev;
+  sq = st->sq;
+  leak = st->leak;
+  k = st->k;
+  nl = st->lanes;
+  num = 0U;
+  ais2dw12_biquad_run(&st->band, buf, buf, len);
+
+  for (n = 0U; n < len; n++)
+  {
+    a = &buf[(uint32_t)n * nl];
+
+    for (l = 0U; l < nl; l++)
+    {
+      v[l] = (leak * v[l]) + (k * (a[l] + p[l]));
+      p[l] = a[l];
+      a[l] = v[l];
+      sq[l] += v[l] * v[l];
+    }
+
+    st->n++;
+
+    if (st->n == st->win)
+    {
+      r = (num < max_win) ? &rms[(uint32_t)num * nl] : NULL;
+
+      for (l = 0U; l < nl; l++)
+      {
+        if (r != NULL)
+        {
+          r[l] = sqrtf(sq[l] / (float_t)st->win);
+        }
+
+        sq[l] = 0.0f;
+      }
+
+      num += (r != NULL) ? 1U : 0U;
+      st->n = 0U;
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Goertzel
+  * @brief     This section groups the functions that track the
+  *            amplitude of a few configured frequencies with a bank of
+  *            Goertzel filters, O(bins) work per sample. Lanes are
+  *            interleaved as in AIS2DW12_Biquad.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a Goertzel bank. Amplitudes are reported every
+  *         m samples; choosing m so that freq * m / odr is an integer
+  *         avoids leakage on stationary tones.
+  *
+  * @param  st       bank state
+  * @param  coef     coefficient storage, bins elements
+  * @param  s        filter state storage, 2 * bins * lanes elements
+  * @param  freq_hz  frequencies to track in Hz, below odr_hz / 2
+  * @param  bins     number of frequencies
+  * @param  lanes    number of lanes
+  * @param  odr_hz   sample rate in Hz
+  * @param  m        samples per report
+  *
+  */
+void ais2dw12_goertzel_init(ais2dw12_goertzel_t *st, float_t *coef,
+                            float_t *s, const float_t *freq_hz,
+                            uint16_t bins, uint16_t lanes, float_t odr_hz,
+                            uint16_t m)
+{
+  uint32_t i;
+  uint16_t b;
+
+  for (b = 0U; b < bins; b++)
+  {
+    coef[b] = 2.0f * cosf((AIS2DW12_2PI * freq_hz[b]) / odr_hz);
+  }
+
+  for (i = 0U; i < (2U * (uint32_t)bins * lanes); i++)
+  {
+    s[i] = 0.0f;
+  }
+
+  st->coef = coef;
+  st->s = s;
+  st->bins = bins;
+  st->lanes = lanes;
+  st->m = m;
+  st->n = 0U;
+}
+
+/**
+  * @brief  Feed len frames to the bank. Every m samples the amplitude
+  *         of each tracked frequency on each lane is written to mag
+  *         ([bin][lane]) and the filters restart.
+  *
+  * @param  st       bank state
+  * @param  in       input frames ([sample][lane])
+  * @param  len      number of frames
+  * @param  mag      amplitude output, max_out * bins * lanes elements
+  * @param  max_out  maximum number of reports
+  * @retval          number of reports
+  *
+  */
+uint16_t ais2dw12_goertzel_run(ais2dw12_goertzel_t *st, const float_t *in,
+                               uint16_t len, float_t *mag, uint16_t max_out)
+{
+  const float_t *x;
+  float_t *s1;
+  float_t *s2;
+  float_t *out;
+  float_t c;
+  float_t s0;
+  float_t p;
+  uint32_t nbl;
+  uint16_t nl;
+  uint16_t num;
+  uint16_t n;
+  uint16_t b;
+  uint16_t l;
+
+  nbl = (uint32_t)st->bins * st->lanes;
+  nl = st->lanes;
+  num = 0U;
+
+  for (n = 0U; n < len; n++)
+  {
+    x = &in[(uint32_t)n * nl];
+
+    for (b = 0U; b < st->bins; b++)
+    {
+      c = st->coef[b];
+      s1 = &st->s[2U * (uint32_t)b * nl];
+      s2 = &s1[nl];
+
+      for (l = 0U; l < nl; l++)
+      {
+        s0 = x[l] + (c * s1[l]) - s2[l];
+        s2[l] = s1[l];
+        s1[l] = s0;
+      }
+    }
+
+    st->n++;
+
+    if (st->n == st->m)
+    {
+      out = (num < max_out) ? &mag[(uint32_t)num * nbl] : NULL;
+
+      for (b = 0U; b < st->bins; b++)
+      {
+        c = st->coef[b];
+        s1 = &st->s[2U * (uint32_t)b * nl];
+        s2 = &s1[nl];
+
+        for (l = 0U; l < nl; l++)
+        {
+          if (out != NULL)
+          {
+            /* |X|^2 = s1^2 + s2^2 - c s1 s2, amplitude = 2 |X| / m */
+            p = (s1[l] * s1[l]) + (s2[l] * s2[l]) - (c * s1[l] * s2[l]);
+            p = (p > 0.0f) ? p : 0.0f;
+            out[((uint32_t)b * nl) + l] = (2.0f * sqrtf(p)) / (float_t)st->m;
+          }
+
+          s1[l] = 0.0f;
+          s2[l] = 0.0f;
+        }
+      }
+
+      num += (out != NULL) ? 1U : 0U;
+      st->n = 0U;
+    }
+  }
+
+  return num;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Spike_Filter
+  * @brief     This section groups the functions that reject single
+  *            sample outliers from raw data frames with a Hampel
+  *            filter (moving median and median absolute deviation),
+  *            sorted by a compare-exchange network across lanes.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a Hampel filter.
+  *
+  * @param  st       filter state
+  * @param  buf      storage, AIS2DW12_HAMPEL_BUF_LEN(w, lanes) elements
+  * @param  rej      rejected samples counters, lanes elements
+  * @param  w        window length, odd, from 3 to AIS2DW12_HAMPEL_MAX_W
+  * @param  lanes    number of lanes
+  * @param  n_sigma  rejection threshold in standard deviations
+  *                  estimated from the MAD, 0 -> plain median filter
+  * @param  min_ths  minimum rejection threshold in LSB, so that a
+  *                  flat signal (MAD = 0) does not reject its noise;
+  *                  ignored if n_sigma is 0
+  * @retval          0 -> initialized, -1 -> invalid window length
+  *
+  */
+int32_t ais2dw12_hampel_init(ais2dw12_hampel_t *st, int16_t *buf,
+                             uint32_t *rej, uint8_t w, uint16_t lanes,
+                             float_t n_sigma, uint16_t min_ths)
+{
+  uint16_t l;
+  int32_t ret;
+
+  ret = 0;
+
+  if ((w < 3U) || (w > AIS2DW12_HAMPEL_MAX_W) || ((w % 2U) == 0U))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    for (l = 0U; l < lanes; l++)
+    {
+      rej[l] = 0U;
+    }
+
+    st->ring = buf;
+    st->tmp = &buf[(uint32_t)w * lanes];
+    st->rej = rej;
+    st->k = n_sigma * 1.4826f;
+    st->min_ths = (n_sigma > 0.0f) ? min_ths : 0U;
+    st->lanes = lanes;
+    st->w = w;
+    st->pos = 0U;
+    st->fill = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Filter len raw frames. The output is delayed by (w - 1) / 2
+  *         frames; each center sample farther than the threshold from
+  *         the window median is replaced by the median and counted.
+  *
+  * @param  st       filter state
+  * @param  in       input frames ([sample][lane])
+  * @param  out      output frames ([sample][lane]), may alias in
+  * @param  len      number of frames
+  *
+  */
+void ais2dw12_hampel_run(ais2dw12_hampel_t *st, const int16_t *in,
+                         int16_t *out, uint16_t len)
+{
+  const int16_t *x;
+  const int16_t *ctr;
+  int16_t *y;
+  int16_t *med;
+  int16_t *mad;
+  int32_t d;
+  float_t ths;
+  uint32_t nwl;
+  uint32_t i;
+  uint16_t nl;
+  uint16_t half;
+  uint16_t n;
+  uint16_t l;
+  uint8_t j;
+
+  nwl = (uint32_t)st->w * st->lanes;
+  nl = st->lanes;
+  half = (uint16_t)st->w / 2U;
+
+  for (n = 0U; n < len; n++)
+  {
+    x = &in[(uint32_t)n * nl];
+    y = &out[(uint32_t)n * nl];
+
+    /* the new frame replaces the oldest one, the first fills them all */
+    for (j = 0U; j < st->w; j++)
+    {
+      if ((st->fill == 0U) || (j == st->pos))
+      {
+        for (l = 0U; l < nl; l++)
+        {
+          st->ring[((uint32_t)j * nl) + l] = x[l];
+        }
+      }
+    }
+
+    st->fill = 1U;
+    st->pos = (st->pos + 1U) % st->w;
+
+    /* oldest frame at pos, center frame half slots later */
+    ctr = &st->ring[(((uint32_t)st->pos + half) % st->w) * nl];
+
+    for (i = 0U; i < nwl; i++)
+    {
+      st->tmp[i] = st->ring[i];
+    }
+
+    sort_net(st->tmp, st->w, nl);
+    med = &st->tmp[(uint32_t)half * nl];
+
+    for (l = 0U; l < nl; l++)
+    {
+      y[l] = med[l];
+    }
+
+    for (j = 0U; j < st->w; j++)
+    {
+      for (l = 0U; l < nl; l++)
+      {
+        d = (int32_t)st->ring[((uint32_t)j * nl) + l] - y[l];
+        d = (d < 0) ? -d : d;
+        st->tmp[((uint32_t)j * nl) + l] = (d > 32767) ? 32767 : (int16_t)d;
+      }
+    }
+
+    sort_net(st->tmp, st->w, nl);
+    mad = &st->tmp[(uint32_t)half * nl];
+
+    for (l = 0U; l < nl; l++)
+    {
+      d = (int32_t)ctr[l] - y[l];
+      d = (d < 0) ? -d : d;
+      ths = st->k * (float_t)mad[l];
+      ths = (ths > (float_t)st->min_ths) ? ths : (float_t)st->min_ths;
+
+      if ((float_t)d <= ths)
+      {
+        y[l] = ctr[l];
+      }
+
+      else
+      {
+        st->rej[l]++;
+      }
+    }
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Time_Alignment
+  * @brief     This section groups the functions that estimate the delay
+  *            between the streams of two devices by FFT cross-correlation
+  *            of a shared excitation, track delay and rate offset over
+  *            time and map device sample indexes on the reference time
+  *            axis.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a cross-correlator of len-sample windows. The
+  *         windows are zero padded to 2 * len for a linear correlation.
+  *
+  * @param  xc       cross-correlator
+  * @param  fwd      real FFT of size 2 * len
+  * @param  inv      FFT of size 4 * len (complex FFT of 2 * len points)
+  * @param  buf      storage, AIS2DW12_XCORR_BUF_LEN(len) elements
+  * @param  len      window length
+  * @retval          0 -> no Error, -1 -> FFT sizes do not match len
+  *
+  */
+int32_t ais2dw12_xcorr_init(ais2dw12_xcorr_t *xc, const ais2dw12_fft_t *fwd,
+                            const ais2dw12_fft_t *inv, float_t *buf,
+                            uint16_t len)
+{
+  int32_t ret;
+
+  ret = 0;
+
+  if ((fwd->n != (2U * (uint32_t)len)) || (inv->n != (4U * (uint32_t)len)))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    xc->fwd = fwd;
+    xc->inv = inv;
+    xc->a = buf;
+    xc->b = &buf[2U * (uint32_t)len];
+    xc->c = &buf[4U * (uint32_t)len];
+    xc->len = len;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Estimate the delay of x with respect to ref, x[n] ~ ref[n - d],
+  *         with parabolic interpolation of the correlation peak.
+  *
+  * @param  xc       cross-correlator
+  * @param  ref      reference window, len samples
+  * @param  x        window of the device to align, len samples
+  * @param  max_lag  largest delay searched, in samples (< len)
+  * @param  delay    delay d in samples
+  * @param  quality  normalized correlation at the peak, [-1 1]
+  * @retval          0 -> no Error, -1 -> no signal in a window
+  *
+  */
+int32_t ais2dw12_xcorr_delay_get(ais2dw12_xcorr_t *xc, const float_t *ref,
+                                 const float_t *x, uint16_t max_lag,
+                                 float_t *delay, float_t *quality)
+{
+  float_t *a;
+  float_t *b;
+  float_t *c;
+  float_t ma;
+  float_t mb;
+  float_t ea;
+  float_t eb;
+  float_t r[3];
+  float_t d;
+  uint16_t m;
+  uint16_t k;
+  uint16_t i;
+  int32_t lag;
+  int32_t best;
+  int32_t ret;
+
+  a = xc->a;
+  b = xc->b;
+  c = xc->c;
+  ma = 0.0f;
+  mb = 0.0f;
+  ea = 0.0f;
+  eb = 0.0f;
+  m = 2U * xc->len;
+  best = 0;
+  ret = 0;
+
+  for (i = 0U; i < xc->len; i++)
+  {
+    ma += ref[i];
+    mb += x[i];
+  }
+
+  ma /= (float_t)xc->len;
+  mb /= (float_t)xc->len;
+
+  for (i = 0U; i < m; i++)
+  {
+    a[i] = (i < xc->len) ? (ref[i] - ma) : 0.0f;
+    b[i] = (i < xc->len) ? (x[i] - mb) : 0.0f;
+    ea += a[i] * a[i];
+    eb += b[i] * b[i];
+  }
+
+  if ((ea <= 0.0f) || (eb <= 0.0f))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    ais2dw12_rfft(xc->fwd, a);
+    ais2dw12_rfft(xc->fwd, b);
+
+    /* conjugate of the cross spectrum conj(A) B, Hermitian extended:
+     * its forward transform is m times the (real) cross-correlation */
+    c[0] = a[0] * b[0];
+    c[1] = 0.0f;
+    c[m] = a[1] * b[1];
+    c[m + 1U] = 0.0f;
+
+    for (k = 1U; k < (m / 2U); k++)
+    {
+      c[2U * k] = (a[2U * k] * b[2U * k]) +
+                  (a[(2U * k) + 1U] * b[(2U * k) + 1U]);
+      c[(2U * k) + 1U] = (a[(2U * k) + 1U] * b[2U * k]) -
+                         (a[2U * k] * b[(2U * k) + 1U]);
+      c[2U * (m - k)] = c[2U * k];
+      c[(2U * (m - k)) + 1U] = -c[(2U * k) + 1U];
+    }
+
+    ais2dw12_cfft(xc->inv, c);
+
+    /* lag l is at l (l >= 0) or at m + l (l < 0) */
+    max_lag = (max_lag < xc->len) ? max_lag : (xc->len - 1U);
+
+    for (lag = -(int32_t)max_lag; lag <= (int32_t)max_lag; lag++)
+    {
+      if (c[2 * ((lag + m) % m)] > c[2 * ((best + m) % m)])
+      {
+        best = lag;
+      }
+    }
+
+    for (i = 0U; i < 3U; i++)
+    {
+      r[i] = c[2 * ((best + (int32_t)i - 1 + m) % m)];
+    }
+
+    d = r[0] - (2.0f * r[1]) + r[2];
+    *delay = (float_t)best;
+
+    if (((best - 1) >= -(int32_t)max_lag) &&
+        ((best + 1) <= (int32_t)max_lag) && (d < 0.0f))
+    {
+      *delay += (0.5f * (r[0] - r[2])) / d;
+    }
+
+    *quality = r[1] / ((float_t)m * sqrtf(ea * eb));
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Initialize a clock alignment fit.
+  *
+  * @param  al       clock alignment state
+  * @param  forget   forgetting factor applied at each update, (0 1],
+  *                  1 -> plain least squares
+  * @param  min_q    minimum correlation quality of accepted estimates
+  *
+  */
+void ais2dw12_clk_align_init(ais2dw12_clk_align_t *al, float_t forget,
+                             float_t min_q)
+{
+  al->sw = 0.0f;
+  al->mt = 0.0f;
+  al->md = 0.0f;
+  al->ctt = 0.0f;
+  al->ctd = 0.0f;
+  al->t0 = 0U;
+  al->offset = 0.0f;
+  al->rate = 0.0f;
+  al->forget = forget;
+  al->min_q = min_q;
+  al->num = 0U;
+}
+
+/**
+  * @brief  Add a delay estimate to the fit
+  *         d(t) = offset + rate * (t - t0), where t is the reference
+  *         stream index of the window and t0 the one of the first
+  *         accepted estimate.
+  *
+  * @param  al       clock alignment state
+  * @param  t        reference stream index of the window
+  * @param  delay    delay estimate in samples
+  * @param  quality  quality of the estimate
+  * @retval          1 -> estimate accepted, 0 -> rejected
+  *
+  */
+uint8_t ais2dw12_clk_align_update(ais2dw12_clk_align_t *al, uint32_t t,
+                                  float_t delay, float_t quality)
+{
+  float_t u;
+  float_t du;
+  float_t w;
+  uint8_t ret;
+
+  ret = 0U;
+
+  if (quality >= al->min_q)
+  {
+    if (al->num == 0U)
+    {
+      al->t0 = t;
+    }
+
+    /* weighted means and centered moments (West update): float_t keeps
+     * its precision as the sums are never squared magnitudes of t */
+    u = (float_t)(t - al->t0);
+    al->sw = (al->sw * al->forget) + 1.0f;
+    w = 1.0f / al->sw;
+    du = u - al->mt;
+    al->mt += w * du;
+    al->md += w * (delay - al->md);
+    al->ctt = (al->ctt * al->forget) + (du * (u - al->mt));
+    al->ctd = (al->ctd * al->forget) + (du * (delay - al->md));
+    al->num++;
+
+    if ((al->num > 1U) && (al->ctt > 0.0f))
+    {
+      al->rate = al->ctd / al->ctt;
+    }
+
+    al->offset = al->md - (al->rate * al->mt);
+    ret = 1U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Delay of a device stream index on the reference time axis:
+  *         the reference stream index is idx minus the returned delay.
+  *         The delay is returned instead of the mapped index so that
+  *         the integer part of idx is kept exactly.
+  *
+  * @param  al       clock alignment state
+  * @param  idx      device stream index (e.g. blk->idx)
+  * @retval          delay in samples, fractional
+  *
+  */
+float_t ais2dw12_clk_align_delay_get(const ais2dw12_clk_align_t *al,
+                                     uint32_t idx)
+{
+  return al->offset + (al->rate * (float_t)(int32_t)(idx - al->t0));
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Anomaly_Detection
+  * @brief     This section groups the functions that score per-window
+  *            feature vectors against an adaptive baseline (EWMA mean
+  *            and covariance) with the Mahalanobis distance, and raise
+  *            events with hysteresis. Memory is fixed per device.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize an anomaly scorer.
+  *
+  * @param  st       scorer state
+  * @param  nf       number of features, up to AIS2DW12_ANOM_MAX_FEAT
+  * @param  alpha    EWMA weight of a new vector in the baseline
+  * @param  warmup   vectors learned before scoring starts
+  * @param  ths_on   score raising an event
+  * @param  ths_off  score ending an event (<= ths_on)
+  * @param  reg      ridge added to the covariance diagonal, in feature
+  *                  units squared, so constant features stay invertible
+  * @retval          0 -> initialized, -1 -> too many features
+  *
+  */
+int32_t ais2dw12_anom_init(ais2dw12_anom_t *st, uint8_t nf, float_t alpha,
+                           uint16_t warmup, float_t ths_on, float_t ths_off,
+                           float_t reg)
+{
+  uint16_t i;
+  int32_t ret;
+
+  ret = 0;
+
+  if ((nf == 0U) || (nf > AIS2DW12_ANOM_MAX_FEAT))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    for (i = 0U; i < ((uint16_t)nf * nf); i++)
+    {
+      st->cov[i] = 0.0f;
+    }
+
+    for (i = 0U; i < nf; i++)
+    {
+      st->mean[i] = 0.0f;
+    }
+
+    st->alpha = alpha;
+    st->ths_on = ths_on;
+    st->ths_off = ths_off;
+    st->reg = reg;
+    st->num = 0U;
+    st->warmup = warmup;
+    st->nf = nf;
+    st->active = PROPERTY_DISABLE;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Score a feature vector, then learn it when no event is
+  *         active, so that the anomaly does not become the baseline.
+  *
+  * @param  st       scorer state
+  * @param  feat     feature vector, nf elements
+  * @param  score    Mahalanobis distance (0 during warm-up)
+  * @retval          event raised by this vector
+  *
+  */
+ais2dw12_anom_evt_t ais2dw12_anom_update(ais2dw12_anom_t *st,
+                                         const float_t *feat,
+                                         float_t *score)
+{
+  ais2dw12_anom_evt_t evt;
+  float_t *l;
+  float_t d[AIS2DW12_ANOM_MAX_FEAT];
+  float_t s;
+  float_t a;
+  uint8_t n;
+  uint8_t i;
+  uint8_t j;
+  uint8_t k;
+  uint8_t pd;
+
+  evt = AIS2DW12_ANOM_NONE;
+  l = st->chol;
+  n = st->nf;
+  pd = PROPERTY_ENABLE;
+
+  for (i = 0U; i < n; i++)
+  {
+    d[i] = feat[i] - st->mean[i];
+  }
+
+  *score = 0.0f;
+
+  if (st->num >= st->warmup)
+  {
+    /* Cholesky factor of cov + reg I, lower triangle of chol */
+    for (j = 0U; (j < n) && (pd == PROPERTY_ENABLE); j++)
+    {
+      for (i = j; i < n; i++)
+      {
+        s = st->cov[(i * n) + j] + ((i == j) ? st->reg : 0.0f);
+
+        for (k = 0U; k < j; k++)
+        {
+          s -= l[(i * n) + k] * l[(j * n) + k];
+        }
+
+        if (i == j)
+        {
+          pd = (s > 0.0f) ? PROPERTY_ENABLE : PROPERTY_DISABLE;
+          l[(j * n) + j] = (s > 0.0f) ? sqrtf(s) : 0.0f;
+        }
+
+        else
+        {
+          l[(i * n) + j] = s / l[(j * n) + j];
+        }
+      }
+    }
+
+    if (pd == PROPERTY_ENABLE)
+    {
+      /* |L^-1 d|^2 by forward substitution */
+      for (i = 0U; i < n; i++)
+      {
+        s = d[i];
+
+        for (k = 0U; k < i; k++)
+        {
+          s -= l[(i * n) + k] * st->y[k];
+        }
+
+        st->y[i] = s / l[(i * n) + i];
+        *score += st->y[i] * st->y[i];
+      }
+
+      *score = sqrtf(*score);
+    }
+
+    if ((st->active == PROPERTY_DISABLE) && (*score > st->ths_on))
+    {
+      st->active = PROPERTY_ENABLE;
+      evt = AIS2DW12_ANOM_START;
+    }
+
+    else if ((st->active == PROPERTY_ENABLE) && (*score < st->ths_off))
+    {
+      st->active = PROPERTY_DISABLE;
+      evt = AIS2DW12_ANOM_END;
+    }
+
+    else
+    {
+      /* no transition */
+    }
+  }
+
+  if (st->active == PROPERTY_DISABLE)
+  {
+    /* cumulative average until 1 / (num + 1) drops below alpha */
+    a = 1.0f / (float_t)(st->num + 1U);
+    a = (a > st->alpha) ? a : st->alpha;
+
+    for (i = 0U; i < n; i++)
+    {
+      st->mean[i] += a * d[i];
+
+      for (j = 0U; j <= i; j++)
+      {
+        s = (1.0f - a) * (st->cov[(i * n) + j] + (a * d[i] * d[j]));
+        st->cov[(i * n) + j] = s;
+        st->cov[(j * n) + i] = s;
+      }
+    }
+
+    st->num += (st->num < 0xFFFFFFFFU) ? 1U : 0U;
+  }
+
+  return evt;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Features
+  * @brief     This section groups the functions that turn one sample
+  *            block per device into fixed-length feature vectors,
+  *            written as rows of a preallocated float or int8 tensor
+  *            for batched inference.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Extract the features of num blocks into a
+  *         [num][AIS2DW12_FEAT_LEN] tensor. For each axis, in the order
+  *         of ais2dw12_feat_idx_t: mean, standard deviation and peak
+  *         of the AC part (mg), zero-crossing rate of the AC part
+  *         (crossings per sample) and mean power (mg^2) in the octave
+  *         bands odr/4-odr/2, odr/8-odr/4, odr/16-odr/8 and below
+  *         odr/16 (Haar wavelet decomposition); then pitch and roll of
+  *         the mean vector (deg).
+  *
+  * @param  blk      blocks, one per device
+  * @param  num      number of blocks
+  * @param  out      feature tensor, num * AIS2DW12_FEAT_LEN elements
+  *
+  */
+void ais2dw12_feat_batch_get(const ais2dw12_blk_t *const *blk, uint16_t num,
+                             float_t *out)
+{
+  const int16_t *raw;
+  float_t *f;
+  float_t *fa;
+  float_t pend[AIS2DW12_FEAT_BANDS];
+  float_t band[AIS2DW12_FEAT_BANDS];
+  float_t sens;
+  float_t mean;
+  float_t sq;
+  float_t peak;
+  float_t prev;
+  float_t v;
+  float_t d;
+  float_t mx;
+  float_t my;
+  float_t mz;
+  uint16_t len;
+  uint16_t zc;
+  uint16_t b;
+  uint16_t i;
+  uint8_t has[AIS2DW12_FEAT_BANDS];
+  uint8_t carry;
+  uint8_t a;
+  uint8_t k;
+
+  for (b = 0U; b < num; b++)
+  {
+    f = &out[(uint32_t)b * AIS2DW12_FEAT_LEN];
+    len = blk[b]->len;
+    sens = fs_sens(blk[b]->fs);
+
+    for (i = 0U; i < AIS2DW12_FEAT_LEN; i++)
+    {
+      f[i] = 0.0f;
+    }
+
+    for (a = 0U; (a < 3U) && (len > 0U); a++)
+    {
+      raw = (a == 0U) ? blk[b]->x : ((a == 1U) ? blk[b]->y : blk[b]->z);
+      mean = 0.0f;
+
+      for (i = 0U; i < len; i++)
+      {
+        mean += (float_t)raw[i];
+      }
+
+      mean = (mean * sens) / (float_t)len;
+      sq = 0.0f;
+      peak = 0.0f;
+      prev = 0.0f;
+      zc = 0U;
+
+      for (k = 0U; k < AIS2DW12_FEAT_BANDS; k++)
+      {
+        band[k] = 0.0f;
+        has[k] = 0U;
+      }
+
+      for (i = 0U; i < len; i++)
+      {
+        v = ((float_t)raw[i] * sens) - mean;
+        sq += v * v;
+        peak = (fabsf(v) > peak) ? fabsf(v) : peak;
+
+        if (((v > 0.0f) && (prev < 0.0f)) || ((v < 0.0f) && (prev > 0.0f)))
+        {
+          zc++;
+        }
+
+        prev = (v != 0.0f) ? v : prev;
+
+        /* orthonormal Haar cascade: details are the octave bands,
+         * the last approximation the low band */
+        carry = 1U;
+
+        for (k = 0U; (k < (AIS2DW12_FEAT_BANDS - 1U)) && (carry == 1U); k++)
+        {
+          if (has[k] == 0U)
+          {
+            pend[k] = v;
+            has[k] = 1U;
+            carry = 0U;
+          }
+
+          else
+          {
+            d = (pend[k] - v) * 0.70710678f;
+            v = (pend[k] + v) * 0.70710678f;
+            has[k] = 0U;
+            band[k] += d * d;
+          }
+        }
+
+        if (carry == 1U)
+        {
+          band[AIS2DW12_FEAT_BANDS - 1U] += v * v;
+        }
+      }
+
+      fa = &f[a * AIS2DW12_FEAT_PER_AXIS];
+      fa[AIS2DW12_FEAT_MEAN] = mean;
+      fa[AIS2DW12_FEAT_STD] = sqrtf(sq / (float_t)len);
+      fa[AIS2DW12_FEAT_PEAK] = peak;
+      fa[AIS2DW12_FEAT_ZCR] = (float_t)zc / (float_t)len;
+
+      for (k = 0U; k < AIS2DW12_FEAT_BANDS; k++)
+      {
+        fa[AIS2DW12_FEAT_BAND0 + k] = band[k] / (float_t)len;
+      }
+    }
+
+    mx = f[AIS2DW12_FEAT_MEAN];
+    my = f[AIS2DW12_FEAT_PER_AXIS + AIS2DW12_FEAT_MEAN];
+    mz = f[(2U * AIS2DW12_FEAT_PER_AXIS) + AIS2DW12_FEAT_MEAN];
+    f[AIS2DW12_FEAT_PITCH] = AIS2DW12_RAD_TO_DEG *
+                             fast_atan2(-mx, sqrtf((my * my) + (mz * mz)));
+    f[AIS2DW12_FEAT_ROLL] = AIS2DW12_RAD_TO_DEG * fast_atan2(my, mz);
+  }
+}
+
+/**
+  * @brief  Quantize a feature tensor to int8:
+  *         q = round(f / scale) + zero_point, saturated.
+  *
+  * @param  in       feature tensor, num * AIS2DW12_FEAT_LEN elements
+  * @param  num      number of feature vectors
+  * @param  scale    scale of each feature, AIS2DW12_FEAT_LEN elements
+  * @param  zp       zero point of each feature, AIS2DW12_FEAT_LEN elements
+  * @param  out      int8 tensor, num * AIS2DW12_FEAT_LEN elements
+  *
+  */
+void ais2dw12_feat_quantize(const float_t *in, uint16_t num,
+                            const float_t *scale, const int8_t *zp,
+                            int8_t *out)
+{
+  float_t q;
+  uint32_t i;
+  uint8_t j;
+
+  for (i = 0U; i < ((uint32_t)num * AIS2DW12_FEAT_LEN);
+       i += AIS2DW12_FEAT_LEN)
+  {
+    for (j = 0U; j < AIS2DW12_FEAT_LEN; j++)
+    {
+      q = (in[i + j] / scale[j]) + (float_t)zp[j];
+      q = (q < 0.0f) ? (q - 0.5f) : (q + 0.5f);
+      q = (q > 127.0f) ? 127.0f : q;
+      q = (q < -128.0f) ? -128.0f : q;
+      out[i + j] = (int8_t)q;
+    }
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Inference
+  * @brief     This section groups the functions that run small int8
+  *            MLP / 1D-CNN models (e.g. on ais2dw12_feat_quantize
+  *            output): int8 weights and activations, int32
+  *            accumulation and fixed-point requantization, same code
+  *            on the node and on the host. Activations ping-pong
+  *            between two halves of a caller-provided scratch buffer.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Fixed-point multiplier and shift of a real requantization
+  *         scale (input scale * weight scale / output scale).
+  *
+  * @param  scale    real scale, > 0
+  * @param  mult     Q31 multiplier in [2^30 2^31)
+  * @param  shift    power of two exponent. A positive shift is
+  *                  applied to the accumulator before the multiplier:
+  *                  it is exact while |acc| < 2^(31 - shift). Larger
+  *                  accumulators saturate to 32 bits, and so does the
+  *                  int8 output, as |acc| * scale >= 2^30 there.
+  * @retval          0 -> no Error, -1 -> scale not positive or out of
+  *                  the 2^AIS2DW12_NN_SHIFT_MIN..2^AIS2DW12_NN_SHIFT_MAX
+  *                  range
+  *
+  */
+int32_t ais2dw12_nn_quant_mult(float_t scale, int32_t *mult, int8_t *shift)
+{
+  int e;
+  float_t m;
+  int64_t q;
+  int32_t ret;
+
+  ret = (scale > 0.0f) ? 0 : -1;
+  m = frexpf(scale, &e);
+  q = (int64_t)((m * 2147483648.0f) + 0.5f);
+
+  if (q >= 2147483647)
+  {
+    q /= 2;
+    e++;
+  }
+
+  /* the rounding shift of nn_requant must stay below 31 bits */
+  if ((e < AIS2DW12_NN_SHIFT_MIN) || (e > AIS2DW12_NN_SHIFT_MAX))
+  {
+    ret = -1;
+  }
+
+  *mult = (int32_t)q;
+  *shift = (int8_t)e;
+
+  return ret;
+}
+
+/**
+  * @brief  Scratch size needed by a model: two buffers as large as the
+  *         largest activation, input included.
+  *
+  * @param  layer    model layers
+  * @param  num      number of layers
+  * @retval          scratch size in bytes
+  *
+  */
+uint32_t ais2dw12_nn_scratch_len(const ais2dw12_nn_layer_t *layer,
+                                 uint8_t num)
+{
+  uint32_t max;
+  uint32_t len;
+  uint8_t i;
+
+  max = 0U;
+
+  for (i = 0U; i < num; i++)
+  {
+    len = (uint32_t)layer[i].in_len * layer[i].in_ch;
+    max = (len > max) ? len : max;
+    len = AIS2DW12_NN_OUT_LEN(&layer[i]);
+    max = (len > max) ? len : max;
+  }
+
+  return 2U * max;
+}
+
+/**
+  * @brief  Initialize a model, checking that the layer shapes chain,
+  *         that the requantization shifts are in range and that the
+  *         scratch buffer is large enough.
+  *
+  * @param  nn       model
+  * @param  layer    model layers
+  * @param  num      number of layers
+  * @param  scratch  scratch buffer
+  * @param  len      scratch buffer size in bytes
+  * @retval          0 -> initialized, -1 -> invalid model or scratch
+  *
+  */
+int32_t ais2dw12_nn_init(ais2dw12_nn_t *nn, const ais2dw12_nn_layer_t *layer,
+                         uint8_t num, int8_t *scratch, uint32_t len)
+{
+  uint32_t need;
+  uint8_t i;
+  int32_t ret;
+
+  need = ais2dw12_nn_scratch_len(layer, num);
+  ret = ((num == 0U) || (len < need)) ? -1 : 0;
+
+  for (i = 0U; (i < num) && (ret == 0); i++)
+  {
+    if ((layer[i].kernel == 0U) || (layer[i].stride == 0U) ||
+        (layer[i].kernel > layer[i].in_len) ||
+        (layer[i].shift < AIS2DW12_NN_SHIFT_MIN) ||
+        (layer[i].shift > AIS2DW12_NN_SHIFT_MAX))
+    {
+      ret = -1;
+    }
+
+    else if ((i > 0U) && (((uint32_t)layer[i].in_len * layer[i].in_ch) !=
+                          AIS2DW12_NN_OUT_LEN(&layer[i - 1U])))
+    {
+      ret = -1;
+    }
+
+    else
+    {
+      /* layer is consistent */
+    }
+  }
+
+  nn->layer = layer;
+  nn->num = num;
+  nn->ping = scratch;
+  nn->pong = &scratch[need / 2U];
+
+  return ret;
+}
+
+/**
+  * @brief  Run the model on a batch of input vectors.
+  *
+  * @param  nn       model
+  * @param  in       input tensor, batch rows of in_len * in_ch of the
+  *                  first layer
+  * @param  out      class scores, batch rows of the last layer output
+  * @param  batch    number of input vectors
+  *
+  */
+void ais2dw12_nn_run(const ais2dw12_nn_t *nn, const int8_t *in, int8_t *out,
+                     uint16_t batch)
+{
+  const ais2dw12_nn_layer_t *ly;
+  const int8_t *x;
+  const int8_t *w;
+  const int8_t *src;
+  int8_t *dst;
+  int32_t acc;
+  uint32_t in_sz;
+  uint32_t out_sz;
+  uint32_t win;
+  uint32_t j;
+  uint16_t b;
+  uint16_t p;
+  uint16_t o;
+  uint16_t out_len;
+  uint8_t i;
+
+  in_sz = (uint32_t)nn->layer[0].in_len * nn->layer[0].in_ch;
+  out_sz = AIS2DW12_NN_OUT_LEN(&nn->layer[nn->num - 1U]);
+
+  for (b = 0U; b < batch; b++)
+  {
+    src = &in[(uint32_t)b * in_sz];
+
+    for (i = 0U; i < nn->num; i++)
+    {
+      ly = &nn->layer[i];
+      dst = (i == (nn->num - 1U)) ? &out[(uint32_t)b * out_sz] :
+            (((i % 2U) == 0U) ? nn->ping : nn->pong);
+      out_len = ((ly->in_len - ly->kernel) / ly->stride) + 1U;
+      win = (uint32_t)ly->kernel * ly->in_ch;
+
+      /* [pos][ch] activations, weights [out_ch][kernel][in_ch]: each
+       * output is a contiguous int8 dot product */
+      for (p = 0U; p < out_len; p++)
+      {
+        x = &src[(uint32_t)p * ly->stride * ly->in_ch];
+
+        for (o = 0U; o < ly->out_ch; o++)
+        {
+          w = &ly->w[(uint32_t)o * win];
+          acc = (ly->bias != NULL) ? ly->bias[o] : 0;
+
+          for (j = 0U; j < win; j++)
+          {
+            acc += (int32_t)w[j] * ((int32_t)x[j] - ly->in_zp);
+          }
+
+          dst[((uint32_t)p * ly->out_ch) + o] =
+            nn_requant(acc, ly->mult, ly->shift, ly->out_zp, ly->relu);
+        }
+      }
+
+      src = dst;
+    }
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Gravity
+  * @brief     This section groups the functions that separate gravity
+  *            from linear acceleration with a complementary low-pass
+  *            filter, fast while the device is at rest and slow while
+  *            it moves. Lanes are devices: each axis is a frame array
+  *            [sample][lane] (SoA), so loops run across devices.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a gravity estimator.
+  *
+  * @param  st       estimator state
+  * @param  g        state storage, AIS2DW12_GRAVITY_BUF_LEN(lanes) elements
+  * @param  lanes    number of lanes (devices)
+  * @param  odr_hz   sample rate in Hz
+  * @param  fc_still low-pass corner in Hz while at rest
+  * @param  fc_move  low-pass corner in Hz while moving (< fc_still)
+  * @param  ths_mg   host stationary test: |a| - 1 g and the change of
+  *                  a since the previous sample both below ths_mg
+  *
+  */
+void ais2dw12_gravity_init(ais2dw12_gravity_t *st, float_t *g,
+                           uint16_t lanes, float_t odr_hz, float_t fc_still,
+                           float_t fc_move, float_t ths_mg)
+{
+  uint32_t i;
+
+  for (i = 0U; i < AIS2DW12_GRAVITY_BUF_LEN(lanes); i++)
+  {
+    g[i] = 0.0f;
+  }
+
+  st->gx = g;
+  st->gy = &g[lanes];
+  st->gz = &g[2U * (uint32_t)lanes];
+  st->px = &g[3U * (uint32_t)lanes];
+  st->py = &g[4U * (uint32_t)lanes];
+  st->pz = &g[5U * (uint32_t)lanes];
+  st->a_still = 1.0f - expf((-AIS2DW12_2PI * fc_still) / odr_hz);
+  st->a_move = 1.0f - expf((-AIS2DW12_2PI * fc_move) / odr_hz);
+  st->ths_mg = ths_mg;
+  st->lanes = lanes;
+  st->init = PROPERTY_DISABLE;
+}
+
+/**
+  * @brief  Read the sleep_state flag of STATUS of several devices, to
+  *         be used as stationary flags by ais2dw12_gravity_run
+  *         (requires the activity / inactivity function enabled).
+  *
+  * @param  ctx      read / write interface definitions, one per device
+  * @param  num      number of devices
+  * @param  still    stationary flags, num elements
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_gravity_still_get(const stmdev_ctx_t *const *ctx,
+                                   uint16_t num, uint8_t *still)
+{
+  ais2dw12_status_t status;
+  uint16_t i;
+  int32_t ret;
+
+  ret = 0;
+
+  for (i = 0U; (i < num) && (ret == 0); i++)
+  {
+    ret = ais2dw12_status_reg_get(ctx[i], &status);
+    still[i] = status.sleep_state;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Update gravity with len frames (mg) and output gravity and
+  *         linear acceleration (mg), all in [sample][lane] layout.
+  *
+  * @param  st       estimator state
+  * @param  x        X-axis input frames
+  * @param  y        Y-axis input frames
+  * @param  z        Z-axis input frames
+  * @param  still    stationary flag of each lane (e.g. from
+  *                  ais2dw12_gravity_still_get), NULL -> host test
+  * @param  len      number of frames
+  * @param  grav     gravity output: X, Y, Z arrays of len * lanes
+  *                  elements, may be NULL
+  * @param  lin      linear acceleration output: X, Y, Z arrays of
+  *                  len * lanes elements, may be NULL
+  *
+  */
+void ais2dw12_gravity_run(ais2dw12_gravity_t *st, const float_t *x,
+                          const float_t *y, const float_t *z,
+                          const uint8_t *still, uint16_t len,
+                          float_t *const *grav, float_t *const *lin)
+{
+  float_t ax;
+  float_t ay;
+  float_t az;
+  float_t dx;
+  float_t dy;
+  float_t dz;
+  float_t n2;
+  float_t a;
+  float_t lo;
+  float_t hi;
+  float_t th2;
+  uint32_t i;
+  uint16_t nl;
+  uint16_t n;
+  uint16_t l;
+  uint8_t rest;
+
+  nl = st->lanes;
+
+  /* |a| - 1 g within ths_mg, compared on squared norms; the lower
+   * bound is 0 when ths_mg reaches 1 g */
+  lo = (st->ths_mg < 1000.0f) ?
+       ((1000.0f - st->ths_mg) * (1000.0f - st->ths_mg)) : 0.0f;
+  hi = (1000.0f + st->ths_mg) * (1000.0f + st->ths_mg);
+  th2 = st->ths_mg * st->ths_mg;
+
+  if ((st->init == PROPERTY_DISABLE) && (len > 0U))
+  {
+    for (l = 0U; l < nl; l++)
+    {
+      st->gx[l] = x[l];
+      st->gy[l] = y[l];
+      st->gz[l] = z[l];
+      st->px[l] = x[l];
+      st->py[l] = y[l];
+      st->pz[l] = z[l];
+    }
+
+    st->init = PROPERTY_ENABLE;
+  }
+
+  for (n = 0U; n < len; n++)
+  {
+    i = (uint32_t)n * nl;
+
+    for (l = 0U; l < nl; l++)
+    {
+      ax = x[i + l];
+      ay = y[i + l];
+      az = z[i + l];
+      dx = ax - st->px[l];
+      dy = ay - st->py[l];
+      dz = az - st->pz[l];
+      st->px[l] = ax;
+      st->py[l] = ay;
+      st->pz[l] = az;
+
+      if (still != NULL)
+      {
+        rest = still[l];
+      }
+
+      else
+      {
+        n2 = (ax * ax) + (ay * ay) + (az * az);
+        rest = ((n2 > lo) && (n2 < hi) &&
+                (((dx * dx) + (dy * dy) + (dz * dz)) < th2)) ?
+               PROPERTY_ENABLE : PROPERTY_DISABLE;
+      }
+
+      a = (rest != PROPERTY_DISABLE) ? st->a_still : st->a_move;
+      st->gx[l] += a * (ax - st->gx[l]);
+      st->gy[l] += a * (ay - st->gy[l]);
+      st->gz[l] += a * (az - st->gz[l]);
+
+      if (grav != NULL)
+      {
+        grav[0][i + l] = st->gx[l];
+        grav[1][i + l] = st->gy[l];
+        grav[2][i + l] = st->gz[l];
+      }
+
+      if (lin != NULL)
+      {
+        lin[0][i + l] = ax - st->gx[l];
+        lin[1][i + l] = ay - st->gy[l];
+        lin[2][i + l] = az - st->gz[l];
+      }
+    }
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,680 @@
+/**
+  ******************************************************************************
+  * @file    ais2dw12_dsp.h
+  * @author  Sensors Software Solution Team
+  * @brief   This file contains all the functions prototypes for the
+  *          ais2dw12_dsp.c host-side
+  *          processing of the driver data.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef AIS2DW12_DSP_H
+#define AIS2DW12_DSP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "ais2dw12_reg.h"
+
+/** @addtogroup AIS2DW12_DSP
+  * @{
+  *
+  */
+
+void ais2dw12_blk_to_mg(const ais2dw12_blk_t *blk, float_t *x, float_t *y,
+                        float_t *z);
+
+#define AIS2DW12_BLK_MG_STORAGE_LEN(num, cap)  \
+  (3U * (uint32_t)(num) * (uint32_t)(cap))
+void ais2dw12_blk_mg_attach(ais2dw12_blk_t *blk, float_t *storage,
+                            uint16_t num);
+
+#define AIS2DW12_STAGE_MAX_BLK               16U
+#define AIS2DW12_STAGE_SOURCE                0xFFFFU
+typedef struct
+{
+  ais2dw12_blk_t **slot;
+  uint16_t size;
+  volatile uint16_t head;     /* written by the upstream producer */
+  volatile uint16_t tail;     /* written by the stage */
+  volatile uint16_t rec;      /* written by the acquisition loop */
+} ais2dw12_blk_queue_t;
+
+typedef int32_t (*ais2dw12_stage_run_t)(void *state,
+                                        ais2dw12_blk_t *const *blk,
+                                        uint16_t num);
+typedef struct ais2dw12_stage_s
+{
+  ais2dw12_stage_run_t run;
+  void *state;
+  uint16_t batch;             /* samples needed to run the stage */
+  uint8_t async;              /* PROPERTY_ENABLE: run by its own thread */
+  ais2dw12_blk_queue_t *queue;
+  uint16_t up;                /* upstream stage or AIS2DW12_STAGE_SOURCE */
+  uint16_t refs;              /* stages fed through this one, itself too */
+  struct ais2dw12_stage_s *child;    /* first downstream stage */
+  struct ais2dw12_stage_s *sibling;  /* next stage with the same upstream */
+} ais2dw12_stage_t;
+
+typedef struct
+{
+  ais2dw12_blk_pool_t *pool;
+  ais2dw12_stream_t *stream;
+  ais2dw12_stage_t *stage;
+  uint16_t num;
+  ais2dw12_blk_t *cur;
+  uint32_t dropped;           /* blocks not queued, stage queue full */
+} ais2dw12_pipeline_t;
+int32_t ais2dw12_blk_queue_init(ais2dw12_blk_queue_t *queue,
+                                ais2dw12_blk_t **slot, uint16_t size);
+int32_t ais2dw12_stage_poll(ais2dw12_stage_t *stage);
+int32_t ais2dw12_stage_to_mg(void *state, ais2dw12_blk_t *const *blk,
+                             uint16_t num);
+int32_t ais2dw12_pipeline_init(ais2dw12_pipeline_t *pipe,
+                               ais2dw12_blk_pool_t *pool,
+                               ais2dw12_stream_t *stream,
+                               ais2dw12_stage_t *stage, uint16_t num);
+int32_t ais2dw12_pipeline_push(ais2dw12_pipeline_t *pipe,
+                               ais2dw12_blk_t *blk);
+int32_t ais2dw12_pipeline_run(const stmdev_ctx_t *ctx,
+                              ais2dw12_pipeline_t *pipe);
+int32_t ais2dw12_pipeline_reconfig(const stmdev_ctx_t *ctx,
+                                   ais2dw12_pipeline_t *pipe,
+                                   const ais2dw12_stream_cfg_t *cfg);
+
+#define AIS2DW12_FFT_MAX                     4096U
+#define AIS2DW12_2PI                         6.28318530718f
+typedef struct
+{
+  const float_t *twiddle;
+  uint16_t n;
+} ais2dw12_fft_t;
+int32_t ais2dw12_fft_init(ais2dw12_fft_t *fft, float_t *twiddle,
+                          uint16_t n);
+void ais2dw12_cfft(const ais2dw12_fft_t *fft, float_t *buf);
+void ais2dw12_rfft(const ais2dw12_fft_t *fft, float_t *buf);
+
+typedef enum
+{
+  AIS2DW12_WIN_HANN       = 0,
+  AIS2DW12_WIN_FLAT_TOP   = 1,
+} ais2dw12_win_t;
+void ais2dw12_window_init(float_t *win, uint16_t n, ais2dw12_win_t type);
+
+typedef struct
+{
+  const ais2dw12_fft_t *fft;
+  const float_t *win;
+  float_t *frame;
+  float_t *work;
+  float_t *out;
+  float_t norm;
+  uint32_t avg;
+  uint32_t max_avg;
+  uint16_t hop;
+  uint16_t fill;
+} ais2dw12_psd_t;
+void ais2dw12_psd_init(ais2dw12_psd_t *psd, const ais2dw12_fft_t *fft,
+                       const float_t *win, float_t *frame, float_t *work,
+                       float_t *out, uint16_t hop, float_t odr_hz,
+                       uint32_t max_avg);
+uint16_t ais2dw12_psd_update(ais2dw12_psd_t *psd, const float_t *x,
+                             uint16_t len);
+
+typedef struct
+{
+  float_t mean[3];
+  float_t rms[3];
+  float_t peak[3];
+  float_t p2p[3];
+  float_t crest[3];
+  float_t skew[3];
+  float_t kurt[3];      /* 3 for a gaussian signal */
+} ais2dw12_stats_out_t;
+
+typedef struct
+{
+  uint32_t win;
+  uint32_t n;
+  float_t mean[3];
+  float_t m2[3];
+  float_t m3[3];
+  float_t m4[3];
+  float_t min[3];
+  float_t max[3];
+} ais2dw12_stats_t;
+void ais2dw12_stats_init(ais2dw12_stats_t *st, uint32_t win);
+uint16_t ais2dw12_stats_update(ais2dw12_stats_t *st, const float_t *x,
+                               const float_t *y, const float_t *z,
+                               uint16_t len, ais2dw12_stats_out_t *out,
+                               uint16_t max_out);
+
+typedef struct
+{
+  float_t *buf;
+  uint32_t *dq;
+  float_t k[3];
+  float_t s[3][4];
+  uint32_t head[3][2];
+  uint32_t tail[3][2];
+  uint32_t cnt;
+  uint16_t win;
+  uint16_t n;
+  uint16_t pos;
+  uint16_t rebase;
+} ais2dw12_stats_sl_t;
+int32_t ais2dw12_stats_sl_init(ais2dw12_stats_sl_t *st, float_t *buf,
+                               uint32_t *dq, uint16_t win);
+void ais2dw12_stats_sl_update(ais2dw12_stats_sl_t *st, const float_t *x,
+                              const float_t *y, const float_t *z,
+                              uint16_t len);
+void ais2dw12_stats_sl_get(const ais2dw12_stats_sl_t *st,
+                           ais2dw12_stats_out_t *out);
+
+#define AIS2DW12_RAD_TO_DEG                  57.2957795f
+typedef struct
+{
+  float_t bias[3];      /* mg, at temperature t0 */
+  float_t bias_tc[3];   /* mg / degC */
+  float_t t0;           /* degC */
+  uint16_t avg;         /* samples averaged per angle (0, 1 -> none) */
+} ais2dw12_tilt_cfg_t;
+uint16_t ais2dw12_tilt_get(const float_t *x, const float_t *y,
+                           const float_t *z, uint16_t len,
+                           const ais2dw12_tilt_cfg_t *cfg, float_t temp_c,
+                           float_t *pitch, float_t *roll, float_t *incl);
+
+typedef struct
+{
+  float_t ths_mg;
+  uint8_t _4d_en;
+  uint8_t pos;          /* SIXD_SRC image of the current position */
+} ais2dw12_6d_host_t;
+void ais2dw12_6d_host_init(ais2dw12_6d_host_t *st, uint8_t ths,
+                           uint8_t _4d_en);
+uint16_t ais2dw12_6d_host_run(ais2dw12_6d_host_t *st, const float_t *x,
+                              const float_t *y, const float_t *z,
+                              uint16_t len, ais2dw12_sixd_src_t *src,
+                              ais2dw12_sixd_src_t *pos);
+
+typedef struct
+{
+  float_t ths_mg;
+  float_t prev[3];
+  ais2dw12_usr_off_on_wu_t feed;
+  uint8_t dur;
+  uint8_t cnt;
+  uint8_t init;
+} ais2dw12_wkup_host_t;
+void ais2dw12_wkup_host_init(ais2dw12_wkup_host_t *st, ais2dw12_fs_t fs,
+                             uint8_t wk_ths, uint8_t wake_dur,
+                             ais2dw12_usr_off_on_wu_t feed);
+uint16_t ais2dw12_wkup_host_run(ais2dw12_wkup_host_t *st, const float_t *x,
+                                const float_t *y, const float_t *z,
+                                uint16_t len, uint16_t *evt,
+                                uint16_t max_evt);
+
+typedef struct
+{
+  float_t ths_mg;
+  uint8_t dur;
+  uint8_t cnt;
+} ais2dw12_ff_host_t;
+void ais2dw12_ff_host_init(ais2dw12_ff_host_t *st, ais2dw12_ff_ths_t ff_ths,
+                           uint8_t ff_dur);
+uint16_t ais2dw12_ff_host_run(ais2dw12_ff_host_t *st, const float_t *x,
+                              const float_t *y, const float_t *z,
+                              uint16_t len, uint16_t *evt,
+                              uint16_t max_evt);
+
+#define AIS2DW12_CIC_MAX_ORDER               4U
+typedef struct
+{
+  uint32_t integ[3][AIS2DW12_CIC_MAX_ORDER];
+  uint32_t comb[3][AIS2DW12_CIC_MAX_ORDER];
+  float_t hist[3][2];
+  float_t comp;
+  float_t norm;
+  uint16_t ratio;
+  uint16_t phase;
+  uint8_t order;
+  uint8_t fill;
+} ais2dw12_decim_t;
+int32_t ais2dw12_decim_init(ais2dw12_decim_t *st, uint8_t order,
+                            uint16_t ratio, float_t comp);
+uint16_t ais2dw12_decim_run(ais2dw12_decim_t *st, const ais2dw12_blk_t *blk,
+                            float_t *x, float_t *y, float_t *z);
+void ais2dw12_decim_noise_get(const ais2dw12_decim_t *st, float_t nd_in,
+                              float_t odr_in, float_t *rms_out,
+                              float_t *nd_out);
+
+typedef enum
+{
+  AIS2DW12_BIQUAD_LOW_PASS    = 0,
+  AIS2DW12_BIQUAD_HIGH_PASS   = 1,
+  AIS2DW12_BIQUAD_BAND_PASS   = 2,
+  AIS2DW12_BIQUAD_NOTCH       = 3,
+} ais2dw12_biquad_type_t;
+
+typedef struct
+{
+  float_t b0;
+  float_t b1;
+  float_t b2;
+  float_t a1;
+  float_t a2;
+} ais2dw12_biquad_coef_t;
+
+typedef struct
+{
+  float_t *coef;        /* [section][b0 b1 b2 a1 a2][lane] */
+  float_t *z;           /* [section][s1 s2][lane] */
+  uint16_t lanes;
+  uint8_t sections;
+} ais2dw12_biquad_t;
+void ais2dw12_biquad_design(ais2dw12_biquad_coef_t *coef,
+                            ais2dw12_biquad_type_t type, float_t fc,
+                            float_t q, float_t odr_hz);
+void ais2dw12_biquad_init(ais2dw12_biquad_t *st, float_t *coef, float_t *z,
+                          uint8_t sections, uint16_t lanes);
+void ais2dw12_biquad_set(ais2dw12_biquad_t *st, uint8_t section,
+                         uint16_t lane, const ais2dw12_biquad_coef_t *coef);
+void ais2dw12_biquad_run(ais2dw12_biquad_t *st, const float_t *in,
+                         float_t *out, uint16_t len);
+
+#define AIS2DW12_ALLAN_LEVELS  32U
+#define AIS2DW12_ALLAN_MIN_CNT 8U
+
+typedef struct
+{
+  float_t prev;
+  float_t c[2];
+  float_t sum;
+  float_t comp;         /* compensation of the rounding of sum */
+  uint32_t cnt;
+  uint32_t in;
+} ais2dw12_allan_lvl_t;
+
+typedef struct
+{
+  ais2dw12_allan_lvl_t lvl[3][AIS2DW12_ALLAN_LEVELS];
+  float_t odr_hz;
+  uint32_t num;
+} ais2dw12_allan_t;
+
+typedef struct
+{
+  float_t tau[AIS2DW12_ALLAN_LEVELS];
+  float_t adev[3][AIS2DW12_ALLAN_LEVELS];
+  float_t noise_density[3];
+  float_t bias_instab[3];
+  uint8_t num;
+} ais2dw12_allan_out_t;
+void ais2dw12_allan_init(ais2dw12_allan_t *st, float_t odr_hz);
+void ais2dw12_allan_update(ais2dw12_allan_t *st, const float_t *x,
+                           const float_t *y, const float_t *z, uint16_t len);
+uint8_t ais2dw12_allan_get(const ais2dw12_allan_t *st,
+                           ais2dw12_allan_out_t *out);
+int32_t ais2dw12_allan_capture(const stmdev_ctx_t *ctx, ais2dw12_allan_t *st,
+                               ais2dw12_mode_t mode, ais2dw12_bw_filt_t bw,
+                               uint32_t num);
+
+#define AIS2DW12_OFS_977UG_MG                0.977f
+#define AIS2DW12_OFS_15MG6_MG                15.6f
+typedef enum
+{
+  AIS2DW12_CALIB_X_UP     = 0,
+  AIS2DW12_CALIB_X_DOWN   = 1,
+  AIS2DW12_CALIB_Y_UP     = 2,
+  AIS2DW12_CALIB_Y_DOWN   = 3,
+  AIS2DW12_CALIB_Z_UP     = 4,
+  AIS2DW12_CALIB_Z_DOWN   = 5,
+} ais2dw12_calib_pos_t;
+
+typedef struct
+{
+  float_t sum[6][3];
+  uint32_t cnt[6];
+} ais2dw12_calib_t;
+void ais2dw12_calib_init(ais2dw12_calib_t *cal);
+void ais2dw12_calib_add(ais2dw12_calib_t *cal, ais2dw12_calib_pos_t pos,
+                        const float_t *x, const float_t *y,
+                        const float_t *z, uint16_t len);
+int32_t ais2dw12_calib_solve(const ais2dw12_calib_t *cal, float_t *bias,
+                             float_t *scale);
+int32_t ais2dw12_calib_offset_get(const float_t *bias,
+                                  ais2dw12_usr_off_w_t *weight,
+                                  int8_t *ofs);
+int32_t ais2dw12_calib_offset_set(const stmdev_ctx_t *ctx,
+                                  const float_t *bias);
+
+typedef enum
+{
+  AIS2DW12_STILL_HOST          = 0,
+  AIS2DW12_STILL_SLEEP_STATE   = 1,
+} ais2dw12_still_src_t;
+
+typedef struct
+{
+  float_t ref[3];
+  float_t bias[3];
+  float_t sum[3];
+  float_t sq[3];
+  float_t shift[3];
+  float_t lsb;
+  float_t alpha;
+  float_t var_ths;
+  uint32_t upd;
+  uint16_t win;
+  uint16_t n;
+  ais2dw12_still_src_t src;
+  ais2dw12_usr_off_w_t weight;
+  int8_t ofs[3];
+  uint8_t still;        /* sleep state at the window start */
+  uint8_t skip;         /* window to discard after an offset update */
+} ais2dw12_bias_track_t;
+int32_t ais2dw12_bias_track_init(const stmdev_ctx_t *ctx,
+                                 ais2dw12_bias_track_t *st,
+                                 const float_t *ref, float_t alpha,
+                                 float_t var_ths, uint16_t win,
+                                 ais2dw12_still_src_t src);
+int32_t ais2dw12_bias_track_run(const stmdev_ctx_t *ctx,
+                                ais2dw12_bias_track_t *st,
+                                const float_t *x, const float_t *y,
+                                const float_t *z, uint16_t len);
+
+typedef struct
+{
+  float_t temp_c;
+  float_t bias[3];      /* mg */
+  float_t scale[3];     /* 1.0 -> ideal */
+} ais2dw12_tcomp_pt_t;
+
+typedef enum
+{
+  AIS2DW12_TCOMP_POLY0   = 0,
+  AIS2DW12_TCOMP_POLY1   = 1,
+  AIS2DW12_TCOMP_POLY2   = 2,
+  AIS2DW12_TCOMP_POLY3   = 3,
+  AIS2DW12_TCOMP_PWL     = 4,
+} ais2dw12_tcomp_model_t;
+
+typedef struct
+{
+  float_t bias[3][256];   /* indexed by (uint8_t)OUT_T */
+  float_t gain[3][256];
+} ais2dw12_tcomp_lut_t;
+int32_t ais2dw12_tcomp_lut_build(ais2dw12_tcomp_lut_t *lut,
+                                 const ais2dw12_tcomp_pt_t *pt,
+                                 uint16_t num, ais2dw12_tcomp_model_t model);
+void ais2dw12_blk_to_mg_comp(const ais2dw12_blk_t *blk,
+                             const ais2dw12_tcomp_lut_t *lut, int8_t *temp,
+                             float_t *x, float_t *y, float_t *z);
+
+#define AIS2DW12_RFC_DEPTH                   32U
+typedef struct
+{
+  float_t stack[AIS2DW12_RFC_DEPTH];    /* residue of open reversals */
+  uint32_t *hist;
+  float_t bin_mg;
+  float_t hyst;
+  float_t ext;
+  uint16_t bins;
+  uint16_t depth;
+  int8_t dir;
+} ais2dw12_rfc_t;
+int32_t ais2dw12_rfc_init(ais2dw12_rfc_t *st, uint32_t *hist, uint16_t bins,
+                          float_t bin_mg, float_t hyst);
+void ais2dw12_rfc_run(ais2dw12_rfc_t *st, const float_t *x, uint16_t len);
+uint16_t ais2dw12_rfc_flush(ais2dw12_rfc_t *st, uint16_t *out);
+
+typedef struct
+{
+  uint32_t *hist;       /* [amplitude][duration] */
+  float_t ths;
+  float_t amp_step;
+  float_t hyst;
+  float_t peak;
+  uint32_t dur;
+  uint8_t amp_bins;
+  uint8_t dur_bins;
+} ais2dw12_shock_t;
+int32_t ais2dw12_shock_init(ais2dw12_shock_t *st, uint32_t *hist,
+                            uint8_t amp_bins, uint8_t dur_bins, float_t ths,
+                            float_t amp_step, float_t hyst);
+uint16_t ais2dw12_shock_run(ais2dw12_shock_t *st, const float_t *x,
+                            uint16_t len);
+uint16_t ais2dw12_shock_flush(ais2dw12_shock_t *st, uint16_t *out);
+
+#define AIS2DW12_VELO_BUF_LEN(lanes)         (17U * (uint32_t)(lanes))
+typedef struct
+{
+  ais2dw12_biquad_t band;
+  float_t *v;           /* velocity, mm/s */
+  float_t *prev;        /* previous band-limited acceleration, mg */
+  float_t *sq;          /* window sum of squares */
+  float_t k;
+  float_t leak;
+  uint16_t lanes;
+  uint16_t win;
+  uint16_t n;
+} ais2dw12_velo_t;
+void ais2dw12_velo_init(ais2dw12_velo_t *st, float_t *buf, uint16_t lanes,
+                        float_t odr_hz, float_t f_lo, float_t f_hi,
+                        uint16_t win);
+uint16_t ais2dw12_velo_run(ais2dw12_velo_t *st, float_t *buf, uint16_t len,
+                           float_t *rms, uint16_t max_win);
+
+typedef struct
+{
+  float_t *coef;        /* [bin] */
+  float_t *s;           /* [bin][s1 s2][lane] */
+  uint16_t bins;
+  uint16_t lanes;
+  uint16_t m;
+  uint16_t n;
+} ais2dw12_goertzel_t;
+void ais2dw12_goertzel_init(ais2dw12_goertzel_t *st, float_t *coef,
+                            float_t *s, const float_t *freq_hz,
+                            uint16_t bins, uint16_t lanes, float_t odr_hz,
+                            uint16_t m);
+uint16_t ais2dw12_goertzel_run(ais2dw12_goertzel_t *st, const float_t *in,
+                               uint16_t len, float_t *mag, uint16_t max_out);
+
+#define AIS2DW12_HAMPEL_MAX_W                9U
+#define AIS2DW12_HAMPEL_BUF_LEN(w, lanes)    \
+  (2U * (uint32_t)(w) * (uint32_t)(lanes))
+typedef struct
+{
+  int16_t *ring;        /* [slot][lane] */
+  int16_t *tmp;         /* [rank][lane] */
+  uint32_t *rej;
+  float_t k;
+  uint16_t min_ths;
+  uint16_t lanes;
+  uint8_t w;
+  uint8_t pos;
+  uint8_t fill;
+} ais2dw12_hampel_t;
+int32_t ais2dw12_hampel_init(ais2dw12_hampel_t *st, int16_t *buf,
+                             uint32_t *rej, uint8_t w, uint16_t lanes,
+                             float_t n_sigma, uint16_t min_ths);
+void ais2dw12_hampel_run(ais2dw12_hampel_t *st, const int16_t *in,
+                         int16_t *out, uint16_t len);
+
+#define AIS2DW12_XCORR_BUF_LEN(len)          (8U * (uint32_t)(len))
+typedef struct
+{
+  const ais2dw12_fft_t *fwd;
+  const ais2dw12_fft_t *inv;
+  float_t *a;
+  float_t *b;
+  float_t *c;
+  uint16_t len;
+} ais2dw12_xcorr_t;
+int32_t ais2dw12_xcorr_init(ais2dw12_xcorr_t *xc, const ais2dw12_fft_t *fwd,
+                            const ais2dw12_fft_t *inv, float_t *buf,
+                            uint16_t len);
+int32_t ais2dw12_xcorr_delay_get(ais2dw12_xcorr_t *xc, const float_t *ref,
+                                 const float_t *x, uint16_t max_lag,
+                                 float_t *delay, float_t *quality);
+
+typedef struct
+{
+  float_t sw;           /* sum of the weights */
+  float_t mt;           /* weighted mean of t - t0 */
+  float_t md;           /* weighted mean of the delay */
+  float_t ctt;
+  float_t ctd;
+  uint32_t t0;
+  float_t offset;       /* delay at t0, samples */
+  float_t rate;         /* delay drift, samples per sample */
+  float_t forget;
+  float_t min_q;
+  uint32_t num;
+} ais2dw12_clk_align_t;
+void ais2dw12_clk_align_init(ais2dw12_clk_align_t *al, float_t forget,
+                             float_t min_q);
+uint8_t ais2dw12_clk_align_update(ais2dw12_clk_align_t *al, uint32_t t,
+                                  float_t delay, float_t quality);
+float_t ais2dw12_clk_align_delay_get(const ais2dw12_clk_align_t *al,
+                                     uint32_t idx);
+
+#define AIS2DW12_ANOM_MAX_FEAT               16U
+typedef enum
+{
+  AIS2DW12_ANOM_NONE    = 0,
+  AIS2DW12_ANOM_START   = 1,
+  AIS2DW12_ANOM_END     = 2,
+} ais2dw12_anom_evt_t;
+
+typedef struct
+{
+  float_t mean[AIS2DW12_ANOM_MAX_FEAT];
+  float_t cov[AIS2DW12_ANOM_MAX_FEAT * AIS2DW12_ANOM_MAX_FEAT];
+  float_t chol[AIS2DW12_ANOM_MAX_FEAT * AIS2DW12_ANOM_MAX_FEAT];
+  float_t y[AIS2DW12_ANOM_MAX_FEAT];
+  float_t alpha;
+  float_t ths_on;
+  float_t ths_off;
+  float_t reg;
+  uint32_t num;
+  uint16_t warmup;
+  uint8_t nf;
+  uint8_t active;
+} ais2dw12_anom_t;
+int32_t ais2dw12_anom_init(ais2dw12_anom_t *st, uint8_t nf, float_t alpha,
+                           uint16_t warmup, float_t ths_on, float_t ths_off,
+                           float_t reg);
+ais2dw12_anom_evt_t ais2dw12_anom_update(ais2dw12_anom_t *st,
+                                         const float_t *feat,
+                                         float_t *score);
+
+#define AIS2DW12_FEAT_BANDS                  4U
+typedef enum
+{
+  AIS2DW12_FEAT_MEAN       = 0,
+  AIS2DW12_FEAT_STD        = 1,
+  AIS2DW12_FEAT_PEAK       = 2,
+  AIS2DW12_FEAT_ZCR        = 3,
+  AIS2DW12_FEAT_BAND0      = 4,   /* AIS2DW12_FEAT_BANDS bands */
+  AIS2DW12_FEAT_PER_AXIS   = 8,   /* X features, then Y, then Z */
+  AIS2DW12_FEAT_PITCH      = 24,
+  AIS2DW12_FEAT_ROLL       = 25,
+  AIS2DW12_FEAT_LEN        = 26,
+} ais2dw12_feat_idx_t;
+void ais2dw12_feat_batch_get(const ais2dw12_blk_t *const *blk, uint16_t num,
+                             float_t *out);
+void ais2dw12_feat_quantize(const float_t *in, uint16_t num,
+                            const float_t *scale, const int8_t *zp,
+                            int8_t *out);
+
+#define AIS2DW12_NN_SHIFT_MIN                (-30)
+#define AIS2DW12_NN_SHIFT_MAX                30
+
+/* A dense layer is a 1D convolution with in_len = kernel = 1 */
+typedef struct
+{
+  const int8_t *w;        /* [out_ch][kernel][in_ch], symmetric */
+  const int32_t *bias;    /* [out_ch], scale in scale * w scale */
+  int32_t mult;           /* requantization, ais2dw12_nn_quant_mult */
+  int8_t shift;           /* AIS2DW12_NN_SHIFT_MIN..AIS2DW12_NN_SHIFT_MAX */
+  int16_t in_zp;
+  int16_t out_zp;
+  uint16_t in_len;
+  uint16_t in_ch;
+  uint16_t out_ch;
+  uint16_t kernel;
+  uint16_t stride;
+  uint8_t relu;
+} ais2dw12_nn_layer_t;
+#define AIS2DW12_NN_OUT_LEN(ly) \
+  (((((uint32_t)(ly)->in_len - (ly)->kernel) / (ly)->stride) + 1U) * \
+   (uint32_t)(ly)->out_ch)
+
+typedef struct
+{
+  const ais2dw12_nn_layer_t *layer;
+  int8_t *ping;
+  int8_t *pong;
+  uint8_t num;
+} ais2dw12_nn_t;
+int32_t ais2dw12_nn_quant_mult(float_t scale, int32_t *mult, int8_t *shift);
+uint32_t ais2dw12_nn_scratch_len(const ais2dw12_nn_layer_t *layer,
+                                 uint8_t num);
+int32_t ais2dw12_nn_init(ais2dw12_nn_t *nn, const ais2dw12_nn_layer_t *layer,
+                         uint8_t num, int8_t *scratch, uint32_t len);
+void ais2dw12_nn_run(const ais2dw12_nn_t *nn, const int8_t *in, int8_t *out,
+                     uint16_t batch);
+
+#define AIS2DW12_GRAVITY_BUF_LEN(lanes)      (6U * (uint32_t)(lanes))
+typedef struct
+{
+  float_t *gx;          /* [lane], mg */
+  float_t *gy;
+  float_t *gz;
+  float_t *px;          /* previous sample, [lane] */
+  float_t *py;
+  float_t *pz;
+  float_t a_still;
+  float_t a_move;
+  float_t ths_mg;
+  uint16_t lanes;
+  uint8_t init;
+} ais2dw12_gravity_t;
+void ais2dw12_gravity_init(ais2dw12_gravity_t *st, float_t *g,
+                           uint16_t lanes, float_t odr_hz, float_t fc_still,
+                           float_t fc_move, float_t ths_mg);
+int32_t ais2dw12_gravity_still_get(const stmdev_ctx_t *const *ctx,
+                                   uint16_t num, uint8_t *still);
+void ais2dw12_gravity_run(ais2dw12_gravity_t *st, const float_t *x,
+                          const float_t *y, const float_t *z,
+                          const uint8_t *still, uint16_t len,
+                          float_t *const *grav, float_t *const *lin);
+
+/**
+  * @}
+  *
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*AIS2DW12_DSP_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
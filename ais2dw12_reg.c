@@ -139,6 +139,11 @@ float_t ais2dw12_from_lsb_to_celsius(int16_t lsb)
   return (((float_t)lsb / 256.0f) + 25.0f);
 }
 
+float_t ais2dw12_from_lsb8_to_celsius(int8_t lsb)
+{
+  return ((float_t)lsb + 25.0f);
+}
+
 /**
   * @}
   *
@@ -608,6 +613,44 @@ int32_t ais2dw12_usr_offset_z_get(const stmdev_ctx_t *ctx, uint8_t *buff)
   return ret;
 }
 
+/**
+  * @brief  Accelerometer X, Y and Z-axis user offset correction written
+  *         with a single burst to X_OFS_USR, Y_OFS_USR, Z_OFS_USR.
+  *         Values are in two’s complement, weight depends on bit
+  *         USR_OFF_W. The values must be in the range [-127 127].[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  buff     buffer that contains data to write (3 bytes)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_usr_offset_set(const stmdev_ctx_t *ctx, uint8_t *buff)
+{
+  int32_t ret;
+
+  ret = ais2dw12_write_reg(ctx, AIS2DW12_X_OFS_USR, buff, 3);
+
+  return ret;
+}
+
+/**
+  * @brief  Accelerometer X, Y and Z-axis user offset correction read
+  *         with a single burst from X_OFS_USR, Y_OFS_USR, Z_OFS_USR.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  buff     buffer that stores data read (3 bytes)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_usr_offset_get(const stmdev_ctx_t *ctx, uint8_t *buff)
+{
+  int32_t ret;
+
+  ret = ais2dw12_read_reg(ctx, AIS2DW12_X_OFS_USR, buff, 3);
+
+  return ret;
+}
+
 /**
   * @brief  Weight of XL user offset bits of registers X_OFS_USR,
   *         Y_OFS_USR, Z_OFS_USR.[set]
@@ -728,6 +771,200 @@ int32_t ais2dw12_acceleration_raw_get(const stmdev_ctx_t *ctx, int16_t *val)
   return ret;
 }
 
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Single_Shot
+  * @brief     This section groups the functions for single data conversion
+  *            on demand (power mode AIS2DW12_SINGLE_PWR_MD_x with odr
+  *            AIS2DW12_XL_SET_SW_TRIG or AIS2DW12_XL_SET_PIN_TRIG).
+  * @{
+  *
+  */
+
+/**
+  * @brief  Start a single data conversion on demand (slp_mode_1 bit in
+  *         CTRL3). The bit is cleared by the device as soon as the
+  *         new sample is available.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_single_shot_trigger_set(const stmdev_ctx_t *ctx)
+{
+  ais2dw12_ctrl3_t reg;
+  int32_t ret;
+
+  ret = ais2dw12_read_reg(ctx, AIS2DW12_CTRL3, (uint8_t *) &reg, 1);
+
+  if (ret == 0)
+  {
+    reg.slp_mode |= 0x01U;
+    ret = ais2dw12_write_reg(ctx, AIS2DW12_CTRL3, (uint8_t *) &reg, 1);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Poll the data-ready flag and read the sample. STATUS and
+  *         OUT_X_L..OUT_Z_H are read with a single 7 byte transaction,
+  *         so when the data is ready no further access is needed.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  poll     poll policy (NULL -> AIS2DW12_POLL_RETRIES_DEF polls
+  *                  spaced by 1 ms)
+  * @param  val      buffer that stores X, Y, Z raw data
+  * @retval          interface status (MANDATORY: return 0 -> no Error),
+  *                  -1 if the sample is not ready within the retries
+  *
+  */
+int32_t ais2dw12_single_shot_data_get(const stmdev_ctx_t *ctx,
+                                      const ais2dw12_poll_t *poll,
+                                      int16_t *val)
+{
+  ais2dw12_status_t status;
+  uint8_t buff[7];
+  uint32_t poll_ms;
+  uint16_t retries;
+  uint16_t i;
+  int32_t ret;
+
+  poll_ms = (poll != NULL) ? poll->poll_ms : 1U;
+  retries = (poll != NULL) ? poll->retries : AIS2DW12_POLL_RETRIES_DEF;
+
+  ret = -1;
+  status.drdy = PROPERTY_DISABLE;
+
+  for (i = 0U; (i < retries) && (status.drdy == PROPERTY_DISABLE); i++)
+  {
+    if ((i > 0U) && (poll_ms > 0U) && (ctx->mdelay != NULL))
+    {
+      ctx->mdelay(poll_ms);
+    }
+
+    ret = ais2dw12_read_reg(ctx, AIS2DW12_STATUS, buff, 7);
+
+    if (ret != 0)
+    {
+      break;
+    }
+
+    bytecpy((uint8_t *)&status, &buff[0]);
+  }
+
+  if ((ret == 0) && (status.drdy == PROPERTY_DISABLE))
+  {
+    ret = -1;
+  }
+
+  if (ret == 0)
+  {
+    val[0] = (int16_t)buff[2];
+    val[0] = (val[0] * 256) + (int16_t)buff[1];
+    val[1] = (int16_t)buff[4];
+    val[1] = (val[1] * 256) + (int16_t)buff[3];
+    val[2] = (int16_t)buff[6];
+    val[2] = (val[2] * 256) + (int16_t)buff[5];
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Single data conversion on demand: trigger, wait and read
+  *         the sample. Device must be already configured in single
+  *         conversion mode with software trigger.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  poll     poll policy (NULL -> default policy, no initial wait)
+  * @param  val      buffer that stores X, Y, Z raw data
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_single_shot_get(const stmdev_ctx_t *ctx,
+                                 const ais2dw12_poll_t *poll,
+                                 int16_t *val)
+{
+  int32_t ret;
+
+  ret = ais2dw12_single_shot_trigger_set(ctx);
+
+  if ((ret == 0) && (poll != NULL) && (poll->wait_ms > 0U) &&
+      (ctx->mdelay != NULL))
+  {
+    ctx->mdelay(poll->wait_ms);
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_single_shot_data_get(ctx, poll, val);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Single data conversion on demand on a set of devices: all the
+  *         devices are triggered first, then a single wait (through the
+  *         mdelay of the first device) is done and all samples are
+  *         collected. For pin trigger set trig to PROPERTY_DISABLE and
+  *         drive INT2 before calling this function.[get]
+  *
+  * @param  ctx      array of read / write interface definitions
+  * @param  num      number of devices
+  * @param  trig     PROPERTY_ENABLE to issue the software trigger
+  * @param  poll     poll policy (NULL -> default policy, no initial wait)
+  * @param  val      buffer that stores X, Y, Z raw data of each device
+  *                  (3 * num elements)
+  * @retval          interface status (MANDATORY: return 0 -> no Error),
+  *                  first error detected
+  *
+  */
+int32_t ais2dw12_single_shot_batch_get(const stmdev_ctx_t *const *ctx,
+                                       uint16_t num, uint8_t trig,
+                                       const ais2dw12_poll_t *poll,
+                                       int16_t *val)
+{
+  int32_t ret;
+  int32_t err;
+  uint16_t i;
+
+  ret = 0;
+
+  for (i = 0U; (i < num) && (trig == PROPERTY_ENABLE); i++)
+  {
+    err = ais2dw12_single_shot_trigger_set(ctx[i]);
+
+    if (ret == 0)
+    {
+      ret = err;
+    }
+  }
+
+  if ((num > 0U) && (poll != NULL) && (poll->wait_ms > 0U) &&
+      (ctx[0]->mdelay != NULL))
+  {
+    ctx[0]->mdelay(poll->wait_ms);
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    err = ais2dw12_single_shot_data_get(ctx[i], poll, &val[3U * i]);
+
+    if (ret == 0)
+    {
+      ret = err;
+    }
+  }
+
+  return ret;
+}
+
 /**
   * @}
   *
@@ -2597,6 +2834,548 @@ int32_t ais2dw12_fifo_wtm_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
   return ret;
 }
 
+/**
+  * @brief  FIFO data burst read. With auto-increment enabled the address
+  *         rolls back from OUT_Z_H to OUT_X_L, so num samples are read
+  *         with a single transaction of 6 * num bytes.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      buffer that stores X, Y, Z raw data, interleaved
+  *                  (3 * num elements)
+  * @param  num      number of samples to read (max AIS2DW12_FIFO_DEPTH)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_fifo_data_get(const stmdev_ctx_t *ctx, int16_t *val,
+                               uint8_t num)
+{
+  uint8_t buff[6U * AIS2DW12_FIFO_DEPTH];
+  uint16_t i;
+  int32_t ret;
+
+  if (num > AIS2DW12_FIFO_DEPTH)
+  {
+    ret = -1;
+  }
+
+  else if (num == 0U)
+  {
+    ret = 0;
+  }
+
+  else
+  {
+    ret = ais2dw12_read_reg(ctx, AIS2DW12_OUT_X_L, buff,
+                            6U * (uint16_t)num);
+
+    for (i = 0U; i < (3U * (uint16_t)num); i++)
+    {
+      val[i] = (int16_t)buff[(2U * i) + 1U];
+      val[i] = (val[i] * 256) + (int16_t)buff[2U * i];
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Sample_Blocks
+  * @brief     This section groups the functions that manage a fixed
+  *            capacity pool of sample blocks. Blocks are taken from
+  *            caller provided storage (no heap), are organized as
+  *            separate X, Y, Z arrays and are reference counted so that
+  *            the same block can be shared by several consumers.
+  *            The pool is not protected against concurrent access.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a sample block pool.
+  *
+  * @param  pool     pool to initialize
+  * @param  blk      array of num block descriptors
+  * @param  storage  sample storage of at least
+  *                  AIS2DW12_BLK_STORAGE_LEN(num, cap) elements; align it
+  *                  to AIS2DW12_BLK_ALIGN bytes to get each axis array
+  *                  cache aligned
+  * @param  num      number of blocks
+  * @param  cap      number of samples per block
+  * @retval          0 -> no Error, -1 -> invalid arguments
+  *
+  */
+int32_t ais2dw12_blk_pool_init(ais2dw12_blk_pool_t *pool,
+                               ais2dw12_blk_t *blk, int16_t *storage,
+                               uint16_t num, uint16_t cap)
+{
+  uint32_t stride;
+  uint16_t i;
+  int32_t ret;
+
+  if ((pool == NULL) || (blk == NULL) || (storage == NULL) || (cap == 0U))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    stride = AIS2DW12_BLK_STRIDE(cap);
+    pool->free = NULL;
+    pool->num = num;
+    pool->avail = num;
+
+    for (i = num; i > 0U; i--)
+    {
+      blk[i - 1U].x = &storage[3U * stride * ((uint32_t)i - 1U)];
+      blk[i - 1U].y = &blk[i - 1U].x[stride];
+      blk[i - 1U].z = &blk[i - 1U].y[stride];
+      blk[i - 1U].cap = cap;
+      blk[i - 1U].len = 0U;
+      blk[i - 1U].ref = 0U;
+      blk[i - 1U].mx = NULL;
+      blk[i - 1U].my = NULL;
+      blk[i - 1U].mz = NULL;
+      blk[i - 1U].next = pool->free;
+      pool->free = &blk[i - 1U];
+    }
+
+    ret = 0;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Take a block from the pool, O(1). The block is returned empty
+  *         and with a reference count of 1.
+  *
+  * @param  pool     sample block pool
+  * @retval          block, NULL if the pool is exhausted
+  *
+  */
+ais2dw12_blk_t *ais2dw12_blk_alloc(ais2dw12_blk_pool_t *pool)
+{
+  ais2dw12_blk_t *blk;
+
+  blk = pool->free;
+
+  if (blk != NULL)
+  {
+    pool->free = blk->next;
+    pool->avail--;
+    blk->next = NULL;
+    blk->len = 0U;
+    blk->idx = 0U;
+    blk->odr = (uint8_t)AIS2DW12_XL_ODR_OFF;
+    blk->fs = (uint8_t)AIS2DW12_2g;
+    blk->mode = (uint8_t)AIS2DW12_PWR_MD_12bit;
+    blk->flags = 0U;
+    blk->ref = 1U;
+  }
+
+  return blk;
+}
+
+/**
+  * @brief  Add a reference to a block shared with a new consumer.
+  *
+  * @param  blk      sample block
+  * @retval          0 -> no Error, -1 -> reference count full
+  *
+  */
+int32_t ais2dw12_blk_ref(ais2dw12_blk_t *blk)
+{
+  int32_t ret;
+
+  if ((blk == NULL) || (blk->ref == 0xFFU))
+  {
+    ret = -1;
+  }
+
+  else
+  {
+    blk->ref++;
+    ret = 0;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Drop a reference to a block, O(1). The block goes back to the
+  *         pool when the last reference is dropped.
+  *
+  * @param  pool     sample block pool
+  * @param  blk      sample block
+  *
+  */
+void ais2dw12_blk_release(ais2dw12_blk_pool_t *pool, ais2dw12_blk_t *blk)
+{
+  if ((blk != NULL) && (blk->ref > 0U))
+  {
+    blk->ref--;
+
+    if (blk->ref == 0U)
+    {
+      blk->next = pool->free;
+      pool->free = blk;
+      pool->avail++;
+    }
+  }
+}
+
+/**
+  * @brief  Drain the FIFO into a sample block. The samples are appended
+  *         to the block, up to its capacity, with a single burst read.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  blk      sample block
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_fifo_blk_get(const stmdev_ctx_t *ctx, ais2dw12_blk_t *blk)
+{
+  int16_t data[3U * AIS2DW12_FIFO_DEPTH];
+  uint8_t level;
+  uint8_t i;
+  int32_t ret;
+
+  ret = ais2dw12_fifo_data_level_get(ctx, &level);
+
+  if (ret == 0)
+  {
+    if ((uint16_t)level > (blk->cap - blk->len))
+    {
+      level = (uint8_t)(blk->cap - blk->len);
+    }
+
+    ret = ais2dw12_fifo_data_get(ctx, data, level);
+  }
+
+  if (ret == 0)
+  {
+    for (i = 0U; i < level; i++)
+    {
+      blk->x[blk->len] = data[3U * i];
+      blk->y[blk->len] = data[(3U * i) + 1U];
+      blk->z[blk->len] = data[(3U * i) + 2U];
+      blk->len++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  AIS2DW12_Stream
+  * @brief     This section groups the functions that acquire the FIFO
+  *            stream into sample blocks.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize a stream descriptor. The configuration tagged
+  *         on the blocks is read from CTRL1 and CTRL6 (single burst),
+  *         then tracked by ais2dw12_stream_reconfig.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  stream   stream descriptor
+  * @param  temp_dec the 8-bit OUT_T register is folded into one FIFO
+  *                  burst every temp_dec bursts (0 -> never)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_stream_init(const stmdev_ctx_t *ctx,
+                             ais2dw12_stream_t *stream, uint16_t temp_dec)
+{
+  ais2dw12_ctrl1_t ctrl1;
+  ais2dw12_ctrl6_t ctrl6;
+  uint8_t reg[6];
+  int32_t ret;
+
+  ret = ais2dw12_read_reg(ctx, AIS2DW12_CTRL1, reg, 6);
+
+  if (ret == 0)
+  {
+    bytecpy((uint8_t *)&ctrl1, &reg[0]);
+    bytecpy((uint8_t *)&ctrl6, &reg[AIS2DW12_CTRL6 - AIS2DW12_CTRL1]);
+    stream->cfg.odr = (ais2dw12_odr_t)ctrl1.odr;
+    stream->cfg.fs = (ais2dw12_fs_t)ctrl6.fs;
+    stream->cfg.mode = (ais2dw12_mode_t)((ctrl1.op_mode << 2) +
+                                         ctrl1.pw_mode);
+  }
+
+  stream->idx = 0U;
+  stream->temp_dec = temp_dec;
+  stream->temp_cnt = 0U;
+  stream->settle = 0U;
+  stream->discont = PROPERTY_DISABLE;
+
+  return ret;
+}
+
+/**
+  * @brief  Drain the FIFO into a sample block keeping track of the
+  *         stream index of every sample. When the temperature is due the
+  *         burst starts from OUT_T (OUT_T, STATUS, then FIFO data), so
+  *         the temperature costs two more bytes but no more transactions.
+  *         The temperature is stored in blk->temp, aligned to sample
+  *         blk->temp_pos, the last one of the burst (OUT_T is
+  *         sampled with the newest FIFO data), and AIS2DW12_BLK_TEMP is
+  *         set in blk->flags. A block keeps one temperature only: a
+  *         later temperature burst into the same block replaces it.
+  *         Samples still settling after ais2dw12_stream_reconfig are
+  *         dropped; nothing is appended to a block flagged
+  *         AIS2DW12_BLK_CLOSED.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  stream   stream descriptor
+  * @param  blk      sample block
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_stream_blk_get(const stmdev_ctx_t *ctx,
+                                ais2dw12_stream_t *stream,
+                                ais2dw12_blk_t *blk)
+{
+  uint8_t buff[2U + (6U * AIS2DW12_FIFO_DEPTH)];
+  uint16_t limit;
+  uint16_t pos;
+  uint16_t off;
+  uint16_t i;
+  uint8_t level;
+  uint8_t temp;
+  int32_t ret;
+
+  if ((blk->flags & AIS2DW12_BLK_CLOSED) != 0U)
+  {
+    ret = 0;
+    level = 0U;
+  }
+
+  else
+  {
+    ret = ais2dw12_fifo_data_level_get(ctx, &level);
+  }
+
+  limit = (blk->cap - blk->len) + stream->settle;
+
+  if ((ret == 0) && ((uint16_t)level > limit))
+  {
+    level = (uint8_t)limit;
+  }
+
+  if ((ret == 0) && (level > 0U))
+  {
+    temp = ((stream->temp_dec > 0U) && (stream->temp_cnt == 0U)) ?
+           PROPERTY_ENABLE : PROPERTY_DISABLE;
+    off = (temp == PROPERTY_ENABLE) ? 2U : 0U;
+
+    ret = ais2dw12_read_reg(ctx,
+                            (temp == PROPERTY_ENABLE) ? AIS2DW12_OUT_T :
+                            AIS2DW12_OUT_X_L, buff,
+                            off + (6U * (uint16_t)level));
+
+    if (ret == 0)
+    {
+      pos = blk->len;
+
+      for (i = 0U; i < (uint16_t)level; i++)
+      {
+        if (stream->settle > 0U)
+        {
+          stream->settle--;
+        }
+
+        else
+        {
+          if (blk->len == 0U)
+          {
+            blk->idx = stream->idx;
+            blk->odr = (uint8_t)stream->cfg.odr;
+            blk->fs = (uint8_t)stream->cfg.fs;
+            blk->mode = (uint8_t)stream->cfg.mode;
+
+            if (stream->discont == PROPERTY_ENABLE)
+            {
+              blk->flags |= AIS2DW12_BLK_DISCONT;
+              stream->discont = PROPERTY_DISABLE;
+            }
+          }
+
+          blk->x[blk->len] = (int16_t)buff[off + 1U];
+          blk->x[blk->len] = (blk->x[blk->len] * 256) + (int16_t)buff[off];
+          blk->y[blk->len] = (int16_t)buff[off + 3U];
+          blk->y[blk->len] = (blk->y[blk->len] * 256) +
+                             (int16_t)buff[off + 2U];
+          blk->z[blk->len] = (int16_t)buff[off + 5U];
+          blk->z[blk->len] = (blk->z[blk->len] * 256) +
+                             (int16_t)buff[off + 4U];
+          blk->len++;
+        }
+
+        stream->idx++;
+        off += 6U;
+      }
+
+      if ((temp == PROPERTY_ENABLE) && (blk->len > pos))
+      {
+        blk->temp = (int8_t)((int16_t)buff[0] -
+                             ((buff[0] > 127U) ? 256 : 0));
+        blk->temp_pos = blk->len - 1U;
+        blk->flags |= AIS2DW12_BLK_TEMP;
+      }
+
+      if (stream->temp_dec > 0U)
+      {
+        stream->temp_cnt++;
+
+        if (stream->temp_cnt >= stream->temp_dec)
+        {
+          stream->temp_cnt = 0U;
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Change data rate, full scale and power mode while streaming.
+  *         The samples still in FIFO are first moved into blk and, when
+  *         blk is full, into the empty block ovf; the blocks that
+  *         received samples are flagged AIS2DW12_BLK_CLOSED: their odr /
+  *         fs / mode tags keep describing the old configuration. The
+  *         samples that are left are counted in the stream index before
+  *         the FIFO is emptied (bypass), then the new configuration is
+  *         applied with a single CTRL1 write (CTRL6 is written only when
+  *         the full scale changes). The samples produced while the
+  *         output settles are dropped, and the first block filled with
+  *         the new configuration is flagged AIS2DW12_BLK_DISCONT.
+  *         Publish blk before ovf to keep the samples in order; with
+  *         a pipeline use ais2dw12_pipeline_reconfig, which does it.
+  *         Single conversion modes and trigger data rates can't be used
+  *         in streaming.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  stream   stream descriptor
+  * @param  blk      current sample block (may be NULL to drop the FIFO
+  *                  content)
+  * @param  ovf      empty block for the samples that don't fit in blk
+  *                  (may be NULL to drop them)
+  * @param  cfg      new configuration
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ais2dw12_stream_reconfig(const stmdev_ctx_t *ctx,
+                                 ais2dw12_stream_t *stream,
+                                 ais2dw12_blk_t *blk, ais2dw12_blk_t *ovf,
+                                 const ais2dw12_stream_cfg_t *cfg)
+{
+  const uint8_t settle[4] = AIS2DW12_SETTLE_SAMPLES;
+  ais2dw12_fifo_ctrl_t fifo_ctrl;
+  ais2dw12_fifo_ctrl_t bypass;
+  ais2dw12_ctrl1_t ctrl1;
+  ais2dw12_ctrl6_t ctrl6;
+  uint8_t level;
+  int32_t ret;
+
+  if ((((uint8_t)cfg->mode & 0x0CU) != 0U) ||
+      (((uint8_t)cfg->odr & 0xF0U) != 0U))
+  {
+    ret = -1;
+  }
+
+  else if (blk != NULL)
+  {
+    ret = ais2dw12_stream_blk_get(ctx, stream, blk);
+    blk->flags |= AIS2DW12_BLK_CLOSED;
+  }
+
+  else
+  {
+    ret = 0;
+  }
+
+  if ((ret == 0) && (blk != NULL) && (ovf != NULL) &&
+      (blk->len == blk->cap))
+  {
+    ret = ais2dw12_stream_blk_get(ctx, stream, ovf);
+
+    if (ovf->len > 0U)
+    {
+      ovf->flags |= AIS2DW12_BLK_CLOSED;
+    }
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_fifo_data_level_get(ctx, &level);
+  }
+
+  if (ret == 0)
+  {
+    /* samples discarded by the bypass write keep their index slots */
+    stream->idx += level;
+    ret = ais2dw12_read_reg(ctx, AIS2DW12_FIFO_CTRL,
+                            (uint8_t *) &fifo_ctrl, 1);
+  }
+
+  if (ret == 0)
+  {
+    bypass = fifo_ctrl;
+    bypass.fmode = (uint8_t)AIS2DW12_BYPASS_MODE;
+    ret = ais2dw12_write_reg(ctx, AIS2DW12_FIFO_CTRL,
+                             (uint8_t *) &bypass, 1);
+  }
+
+  if (ret == 0)
+  {
+    ctrl1.odr = (uint8_t)cfg->odr;
+    ctrl1.op_mode = ((uint8_t)cfg->mode & 0x0CU) >> 2;
+    ctrl1.pw_mode = (uint8_t)cfg->mode & 0x03U;
+    ret = ais2dw12_write_reg(ctx, AIS2DW12_CTRL1, (uint8_t *) &ctrl1, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_read_reg(ctx, AIS2DW12_CTRL6, (uint8_t *) &ctrl6, 1);
+  }
+
+  if ((ret == 0) && (ctrl6.fs != (uint8_t)cfg->fs))
+  {
+    ctrl6.fs = (uint8_t)cfg->fs;
+    ret = ais2dw12_write_reg(ctx, AIS2DW12_CTRL6, (uint8_t *) &ctrl6, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = ais2dw12_write_reg(ctx, AIS2DW12_FIFO_CTRL,
+                             (uint8_t *) &fifo_ctrl, 1);
+  }
+
+  if (ret == 0)
+  {
+    stream->cfg = *cfg;
+    stream->settle = settle[ctrl6.bw_filt];
+    stream->discont = PROPERTY_ENABLE;
+  }
+
+  return ret;
+}
+
 /**
   * @}
   *
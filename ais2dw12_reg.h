@@ -605,6 +605,7 @@ float_t ais2dw12_from_fs2_12bit_to_mg(int16_t lsb);
 float_t ais2dw12_from_fs4_12bit_to_mg(int16_t lsb);
 
 float_t ais2dw12_from_lsb_to_celsius(int16_t lsb);
+float_t ais2dw12_from_lsb8_to_celsius(int8_t lsb);
 
 typedef enum
 {
@@ -675,6 +676,9 @@ int32_t ais2dw12_usr_offset_y_get(const stmdev_ctx_t *ctx, uint8_t *buff);
 int32_t ais2dw12_usr_offset_z_set(const stmdev_ctx_t *ctx, uint8_t *buff);
 int32_t ais2dw12_usr_offset_z_get(const stmdev_ctx_t *ctx, uint8_t *buff);
 
+int32_t ais2dw12_usr_offset_set(const stmdev_ctx_t *ctx, uint8_t *buff);
+int32_t ais2dw12_usr_offset_get(const stmdev_ctx_t *ctx, uint8_t *buff);
+
 typedef enum
 {
   AIS2DW12_LSb_977ug    = 0,
@@ -690,6 +694,25 @@ int32_t ais2dw12_temperature_raw_get(const stmdev_ctx_t *ctx, int16_t *val);
 int32_t ais2dw12_acceleration_raw_get(const stmdev_ctx_t *ctx,
                                       int16_t *val);
 
+#define AIS2DW12_POLL_RETRIES_DEF            100U
+typedef struct
+{
+  uint32_t wait_ms;   /* delay after trigger, before the first poll */
+  uint32_t poll_ms;   /* delay between two consecutive polls */
+  uint16_t retries;   /* maximum number of polls */
+} ais2dw12_poll_t;
+int32_t ais2dw12_single_shot_trigger_set(const stmdev_ctx_t *ctx);
+int32_t ais2dw12_single_shot_data_get(const stmdev_ctx_t *ctx,
+                                      const ais2dw12_poll_t *poll,
+                                      int16_t *val);
+int32_t ais2dw12_single_shot_get(const stmdev_ctx_t *ctx,
+                                 const ais2dw12_poll_t *poll,
+                                 int16_t *val);
+int32_t ais2dw12_single_shot_batch_get(const stmdev_ctx_t *const *ctx,
+                                       uint16_t num, uint8_t trig,
+                                       const ais2dw12_poll_t *poll,
+                                       int16_t *val);
+
 int32_t ais2dw12_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff);
 
 int32_t ais2dw12_auto_increment_set(const stmdev_ctx_t *ctx, uint8_t val);
@@ -738,6 +761,10 @@ typedef enum
   AIS2DW12_ODR_DIV_10    = 2,
   AIS2DW12_ODR_DIV_20    = 3,
 } ais2dw12_bw_filt_t;
+/* Samples to drop after a data rate / power mode change, indexed by
+ * ais2dw12_bw_filt_t: the LPF2 output settles in 1.1 periods of the
+ * cutoff, i.e. 1.1 x the ODR divider (2, 4, 10, 20) rounded up. */
+#define AIS2DW12_SETTLE_SAMPLES              { 3U, 5U, 11U, 22U }
 int32_t ais2dw12_filter_bandwidth_set(const stmdev_ctx_t *ctx,
                                       ais2dw12_bw_filt_t val);
 int32_t ais2dw12_filter_bandwidth_get(const stmdev_ctx_t *ctx,
@@ -907,6 +934,85 @@ int32_t ais2dw12_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t ais2dw12_fifo_wtm_flag_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
+#define AIS2DW12_FIFO_DEPTH                  32U
+int32_t ais2dw12_fifo_data_get(const stmdev_ctx_t *ctx, int16_t *val,
+                               uint8_t num);
+
+/** Sample blocks: each axis array starts on a AIS2DW12_BLK_ALIGN boundary
+  * if the storage does
+  */
+#define AIS2DW12_BLK_ALIGN                   32U
+#define AIS2DW12_BLK_STRIDE(cap)   \
+  ((((uint32_t)(cap) * 2U) + AIS2DW12_BLK_ALIGN - 1U) / \
+   AIS2DW12_BLK_ALIGN * (AIS2DW12_BLK_ALIGN / 2U))
+#define AIS2DW12_BLK_STORAGE_LEN(num, cap)  \
+  (3U * (uint32_t)(num) * AIS2DW12_BLK_STRIDE(cap))
+
+typedef struct ais2dw12_blk_s
+{
+  int16_t *x;
+  int16_t *y;
+  int16_t *z;
+  uint16_t cap;
+  uint16_t len;
+  uint32_t idx;       /* stream index of the first sample */
+  int8_t temp;        /* OUT_T side channel, 1 LSB = 1 degC, 0 = 25 degC */
+  uint16_t temp_pos;  /* sample aligned to temp, one temp per block */
+  uint8_t odr;        /* ais2dw12_odr_t of the samples */
+  uint8_t fs;         /* ais2dw12_fs_t of the samples */
+  uint8_t mode;       /* ais2dw12_mode_t of the samples */
+  uint8_t flags;
+  uint8_t ref;
+  float_t *mx;        /* samples in mg, valid if AIS2DW12_BLK_MG is set */
+  float_t *my;
+  float_t *mz;
+  struct ais2dw12_blk_s *next;
+} ais2dw12_blk_t;
+#define AIS2DW12_BLK_TEMP                    0x01U
+#define AIS2DW12_BLK_DISCONT                 0x02U  /* new configuration */
+#define AIS2DW12_BLK_CLOSED                  0x04U  /* no more samples */
+#define AIS2DW12_BLK_MG                      0x08U  /* mx, my, mz filled */
+
+typedef struct
+{
+  ais2dw12_blk_t *free;
+  uint16_t num;
+  uint16_t avail;
+} ais2dw12_blk_pool_t;
+int32_t ais2dw12_blk_pool_init(ais2dw12_blk_pool_t *pool,
+                               ais2dw12_blk_t *blk, int16_t *storage,
+                               uint16_t num, uint16_t cap);
+ais2dw12_blk_t *ais2dw12_blk_alloc(ais2dw12_blk_pool_t *pool);
+int32_t ais2dw12_blk_ref(ais2dw12_blk_t *blk);
+void ais2dw12_blk_release(ais2dw12_blk_pool_t *pool, ais2dw12_blk_t *blk);
+int32_t ais2dw12_fifo_blk_get(const stmdev_ctx_t *ctx, ais2dw12_blk_t *blk);
+
+typedef struct
+{
+  ais2dw12_odr_t odr;
+  ais2dw12_fs_t fs;
+  ais2dw12_mode_t mode;
+} ais2dw12_stream_cfg_t;
+
+typedef struct
+{
+  uint32_t idx;        /* stream index of the next sample */
+  uint16_t temp_dec;   /* OUT_T folded in every temp_dec bursts */
+  uint16_t temp_cnt;
+  ais2dw12_stream_cfg_t cfg;
+  uint8_t settle;      /* samples still to be dropped */
+  uint8_t discont;
+} ais2dw12_stream_t;
+int32_t ais2dw12_stream_init(const stmdev_ctx_t *ctx,
+                             ais2dw12_stream_t *stream, uint16_t temp_dec);
+int32_t ais2dw12_stream_blk_get(const stmdev_ctx_t *ctx,
+                                ais2dw12_stream_t *stream,
+                                ais2dw12_blk_t *blk);
+int32_t ais2dw12_stream_reconfig(const stmdev_ctx_t *ctx,
+                                 ais2dw12_stream_t *stream,
+                                 ais2dw12_blk_t *blk, ais2dw12_blk_t *ovf,
+                                 const ais2dw12_stream_cfg_t *cfg);
+
 /**
   * @}
   *